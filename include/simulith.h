@@ -15,6 +15,9 @@
 // Include interface headers
 #include "simulith_transport.h"
 #include "simulith_time.h"
+#include "simulith_clock.h"
+#include "simulith_gpio.h"
+#include "simulith_timer.h"
 
 // Defines
 #define SERVER_PUB_ADDR "tcp://0.0.0.0:50000"
@@ -28,6 +31,8 @@
 
 #define INTERVAL_NS 10000000UL // 10ms tick interval
 
+#define SIMULITH_ACK_MAX 192 // Longest tick ACK: "<id>[ step=<ns>][ wait=<ns> cb=<ns>]"
+
 #define SIMULITH_UART_BASE_PORT 51000
 #define SIMULITH_I2C_BASE_PORT  52000
 #define SIMULITH_SPI_BASE_PORT  53000
@@ -41,12 +46,132 @@ extern "C"
     // Logging function
     void simulith_log(const char *fmt, ...);
 
+    /**
+     * Tick frame published by the server on every tick.
+     */
+    typedef struct
+    {
+        uint64_t time_ns;     // Sim time of this tick in nanoseconds
+        uint64_t interval_ns; // Step from this tick to the next in nanoseconds
+        double   speed;       // Target sim seconds per real second; 0 while not paced (pre-roll)
+    } simulith_tick_frame_t;
+
+    /**
+     * Decode a received tick frame. Legacy frames carrying only the time are
+     * accepted and reported with an interval of INTERVAL_NS; frames without a
+     * speed are reported at 1.0.
+     *
+     * @param buf The received message.
+     * @param len The received message size in bytes.
+     * @param frame Frame to populate.
+     * @return 0 on success, -1 if the message is not a tick frame.
+     */
+    int simulith_tick_frame_decode(const void *buf, size_t len, simulith_tick_frame_t *frame);
+
+#define SIMULITH_HIST_BUCKETS 32
+
+    /**
+     * Log2 latency histogram. Bucket i counts samples in [2^i, 2^(i+1)) ns;
+     * the last bucket also holds everything longer (about 2 s and up).
+     */
+    typedef struct
+    {
+        uint64_t count;
+        uint64_t total_ns;
+        uint64_t max_ns;
+        uint64_t buckets[SIMULITH_HIST_BUCKETS];
+    } simulith_histogram_t;
+
+    /**
+     * Add one sample to a histogram.
+     *
+     * @param hist Histogram to update.
+     * @param ns Sample in nanoseconds.
+     */
+    void simulith_histogram_record(simulith_histogram_t *hist, uint64_t ns);
+
+    /**
+     * Estimate a percentile from a histogram.
+     *
+     * @param hist Histogram to read.
+     * @param percentile Percentile in the range 0..100.
+     * @return Upper bound in nanoseconds of the bucket holding the percentile, 0 if empty.
+     */
+    uint64_t simulith_histogram_percentile(const simulith_histogram_t *hist, double percentile);
+
+    /**
+     * Client timing statistics, one sample per tick.
+     *
+     * wait:     time blocked on the subscriber until the tick arrived
+     * callback: time spent processing the tick (the run loop callback, or the
+     *           caller's time between wait_for_tick calls)
+     * ack:      time to send the ACK. ACKs are not confirmed, so the rest of the
+     *           barrier round trip appears as wait.
+     */
+    typedef struct
+    {
+        simulith_histogram_t wait;
+        simulith_histogram_t callback;
+        simulith_histogram_t ack;
+    } simulith_client_stats_t;
+
 #ifdef SIMULITH_TESTING
     /* Test-only helper to reset logging state between tests. Only available
      * when building tests (SIMULITH_TESTING). */
     void simulith_log_reset_for_tests(void);
 #endif
 
+    // ---------- Shared Memory Helpers ----------
+
+#define SIMULITH_SHM_CREATE 0x1 // Create the object (or take it over) and size it
+#define SIMULITH_SHM_WRITE  0x2 // Map it writable
+
+    /**
+     * Map a POSIX shared-memory object, as used by the clock and GPIO banks.
+     *
+     * @param name Object name starting with '/', or NULL for anonymous memory
+     *             private to this process (always writable).
+     * @param size In: bytes to map (the new size with SIMULITH_SHM_CREATE), or 0
+     *             to map the whole existing object. Out: bytes mapped.
+     * @param flags SIMULITH_SHM_CREATE and/or SIMULITH_SHM_WRITE.
+     * @return The mapping, NULL if the object is missing or smaller than *size.
+     */
+    void *simulith_shm_map(const char *name, size_t *size, int flags);
+
+    /**
+     * Unmap memory from simulith_shm_map().
+     *
+     * @param addr The mapping.
+     * @param size Bytes mapped, as returned through size.
+     */
+    void simulith_shm_unmap(void *addr, size_t size);
+
+    // ---------- Shared Context API ----------
+
+    /**
+     * Configure the process-wide ZMQ context. Must be called before any Simulith
+     * socket is created; otherwise SIMULITH_IO_THREADS and SIMULITH_IO_AFFINITY
+     * (a CPU list such as "0,2") are read from the environment.
+     *
+     * @param io_threads Number of ZMQ I/O threads (0 = ZMQ default).
+     * @param cpu_mask Bitmask of CPUs the I/O threads may run on (0 = no affinity).
+     * @return 0 on success, -1 if the context already exists or on invalid arguments.
+     */
+    int simulith_context_configure(int io_threads, uint64_t cpu_mask);
+
+    /**
+     * Take a reference to the process-wide ZMQ context, creating it if needed.
+     *
+     * @return The shared context, NULL on error.
+     */
+    void *simulith_context_acquire(void);
+
+    /**
+     * Drop a reference to the process-wide ZMQ context. The last release
+     * terminates it, so all sockets created from it must be closed first.
+     */
+    void simulith_context_release(void);
+
     // ---------- Server API ----------
 
     /**
@@ -60,6 +185,29 @@ extern "C"
      */
     int simulith_server_init(const char *pub_bind, const char *rep_bind, int client_count, uint64_t interval_ns);
 
+    /**
+     * Allow the tick interval to vary between min_ns and max_ns. Each step is the
+     * smallest maximum requested by the clients (see simulith_client_set_max_step),
+     * clamped to these limits. By default both limits equal the init interval.
+     *
+     * @param min_ns The smallest allowed interval in nanoseconds.
+     * @param max_ns The largest allowed interval in nanoseconds.
+     * @return 0 on success, -1 on error.
+     */
+    int simulith_server_set_interval_limits(uint64_t min_ns, uint64_t max_ns);
+
+    /**
+     * Schedule a fast-forward pre-roll: run unthrottled until sim time until_ns,
+     * then continue paced at the given speed. The pacing base is re-anchored at
+     * until_ns so the transition does not burst or stall. Call after
+     * simulith_server_init; also available at runtime via the 'ff' CLI command.
+     *
+     * @param until_ns Sim time in nanoseconds at which pre-roll ends (0 cancels).
+     * @param speed The attempted speed after pre-roll (1.0 = real time).
+     * @return 0 on success, -1 on error.
+     */
+    int simulith_server_set_preroll(uint64_t until_ns, double speed);
+
     /**
      * Run the main server loop. Blocks forever.
      */
@@ -91,18 +239,34 @@ extern "C"
     int simulith_client_init(const char *pub_addr, const char *rep_addr, const char *id, uint64_t rate_ns);
 
     /**
-     * Handshake with the Simulith server.
+     * Handshake with the Simulith server. Polls for the server with exponential
+     * backoff until the handshake timeout expires, so it may be called before the
+     * server is up.
      *
      * @return 0 on success, -1 on error.
      */
     int simulith_client_handshake(void);
 
     /**
-     * Starts the client's main loop.
+     * Set how long the handshake waits for the server (default 1000 ms).
+     *
+     * @param timeout_ms Handshake deadline in milliseconds.
+     */
+    void simulith_client_set_handshake_timeout(int timeout_ms);
+
+    /**
+     * Starts the client's main loop. Returns after simulith_client_stop().
      *
      * @param on_tick Callback to invoke each time a new tick is received.
+     * @return 0 once stopped, -1 if the tick socket fails.
      */
-    void simulith_client_run_loop(simulith_tick_callback on_tick);
+    int simulith_client_run_loop(simulith_tick_callback on_tick);
+
+    /**
+     * Ask the run loop to return within about 100 ms. Safe to call from a signal
+     * handler or another thread.
+     */
+    void simulith_client_stop(void);
 
     /**
      * Wait for next tick and send acknowledgment (non-blocking API for OSAL use).
@@ -112,11 +276,261 @@ extern "C"
      */
     int simulith_client_wait_for_tick(uint64_t* tick_time_ns);
 
+    /**
+     * Take a tick if one is queued and send acknowledgment, without blocking.
+     *
+     * @param tick_time_ns Pointer to store the tick time in nanoseconds.
+     * @return 0 if a tick was taken, 1 if none is queued, -1 on error.
+     */
+    int simulith_client_try_tick(uint64_t *tick_time_ns);
+
+    /**
+     * Wait up to timeout_ms for the next tick and send acknowledgment.
+     *
+     * @param tick_time_ns Pointer to store the tick time in nanoseconds.
+     * @param timeout_ms Longest wait in milliseconds; 0 behaves like try_tick.
+     * @return 0 if a tick was taken, 1 on timeout, -1 on error.
+     */
+    int simulith_client_wait_for_tick_timeout(uint64_t *tick_time_ns, int timeout_ms);
+
+    /**
+     * Get a file descriptor for the tick socket to add to a poll/epoll set.
+     * The fd is edge-triggered: when it becomes readable, call
+     * simulith_client_try_tick() until it returns 1 before waiting again.
+     *
+     * @param fd Receives the file descriptor.
+     * @return 0 on success, -1 on error.
+     */
+    int simulith_client_get_fd(int *fd);
+
+    /**
+     * Copy the client's timing statistics. Values are exact when read from the
+     * thread that drives the client.
+     *
+     * @param stats Receives the statistics.
+     * @return 0 on success, -1 on error.
+     */
+    int simulith_client_get_stats(simulith_client_stats_t *stats);
+
+    /**
+     * Clear the client's timing statistics.
+     */
+    void simulith_client_reset_stats(void);
+
+    /**
+     * Report the last wait and callback times to the server in each ACK, where
+     * they are summarised per client in the periodic status log.
+     *
+     * @param enable Non-zero to report.
+     */
+    void simulith_client_set_stats_report(int enable);
+
+    /**
+     * Publish every received tick into a shared-memory clock that other threads
+     * and processes read with simulith_clock_open(). The clock is removed when
+     * the client shuts down.
+     *
+     * @param name Shared-memory object name, e.g. SIMULITH_CLOCK_NAME, or NULL
+     *             for a clock private to this process (see simulith_client_get_clock).
+     * @return 0 on success, -1 on error.
+     */
+    int simulith_client_publish_clock(const char *name);
+
+    /**
+     * Get the clock the client publishes into, for reading sim time (including
+     * simulith_clock_interpolated_ns) from any thread.
+     *
+     * @return Clock handle, NULL if the client does not publish one.
+     */
+    const simulith_clock_t *simulith_client_get_clock(void);
+
+    /**
+     * Request a maximum step for the tick interval. Sent to the server with each
+     * ACK and takes effect from the step after the next tick.
+     *
+     * @param max_step_ns Largest acceptable interval in nanoseconds (0 clears the request).
+     */
+    void simulith_client_set_max_step(uint64_t max_step_ns);
+
+    /**
+     * Interval announced with the most recently received tick.
+     *
+     * @return Step from the last tick to the next in nanoseconds, 0 if no tick received.
+     */
+    uint64_t simulith_client_get_tick_interval(void);
+
     /**
      * Shut down the client and release resources.
      */
     void simulith_client_shutdown(void);
 
+    // ---------- Reentrant Client API ----------
+    //
+    // Each handle is an independent client with its own ID, rate and sockets;
+    // handles share the process-wide ZMQ context and its I/O threads. The
+    // functions above operate on a default instance.
+
+    /**
+     * Opaque client handle.
+     */
+    typedef struct simulith_client simulith_client_t;
+
+    /**
+     * Create a Simulith client.
+     *
+     * @param pub_addr The ZeroMQ SUB socket connect address.
+     * @param rep_addr The server request socket connect address.
+     * @param id The unique identifier string for this client.
+     * @param rate_ns The update rate in nanoseconds.
+     * @return Client handle, NULL on error.
+     */
+    simulith_client_t *simulith_client_create(const char *pub_addr, const char *rep_addr, const char *id, uint64_t rate_ns);
+
+    /**
+     * Create a passive observer. Observers receive ticks but never ACK them, so
+     * they are not part of the barrier or the server's expected client count.
+     * An observer that falls behind skips to the latest tick. Handshake is a
+     * no-op and the run loop and wait functions do not acknowledge.
+     *
+     * @param pub_addr The ZeroMQ SUB socket connect address.
+     * @param id Identifier used in log messages.
+     * @return Client handle, NULL on error.
+     */
+    simulith_client_t *simulith_client_create_observer(const char *pub_addr, const char *id);
+
+    /**
+     * Handshake with the Simulith server.
+     *
+     * @param client Client handle.
+     * @return 0 on success, -1 on error.
+     */
+    int simulith_client_handshake_r(simulith_client_t *client);
+
+    /**
+     * Set how long the handshake waits for the server (default 1000 ms).
+     *
+     * @param client Client handle.
+     * @param timeout_ms Handshake deadline in milliseconds.
+     */
+    void simulith_client_set_handshake_timeout_r(simulith_client_t *client, int timeout_ms);
+
+    /**
+     * Starts the client's main loop.
+     *
+     * @param client Client handle.
+     * @param on_tick Callback to invoke each time a new tick is received.
+     * @return 0 once stopped, -1 on invalid parameters or if the tick socket fails.
+     */
+    int simulith_client_run_loop_r(simulith_client_t *client, simulith_tick_callback on_tick);
+
+    /**
+     * Ask the handle's run loop to return within about 100 ms.
+     *
+     * @param client Client handle.
+     */
+    void simulith_client_stop_r(simulith_client_t *client);
+
+    /**
+     * Wait for next tick and send acknowledgment.
+     *
+     * @param client Client handle.
+     * @param tick_time_ns Pointer to store the tick time in nanoseconds.
+     * @return 0 on success, -1 on error.
+     */
+    int simulith_client_wait_for_tick_r(simulith_client_t *client, uint64_t *tick_time_ns);
+
+    /**
+     * Take a tick if one is queued and send acknowledgment, without blocking.
+     *
+     * @param client Client handle.
+     * @param tick_time_ns Pointer to store the tick time in nanoseconds.
+     * @return 0 if a tick was taken, 1 if none is queued, -1 on error.
+     */
+    int simulith_client_try_tick_r(simulith_client_t *client, uint64_t *tick_time_ns);
+
+    /**
+     * Wait up to timeout_ms for the next tick and send acknowledgment.
+     *
+     * @param client Client handle.
+     * @param tick_time_ns Pointer to store the tick time in nanoseconds.
+     * @param timeout_ms Longest wait in milliseconds.
+     * @return 0 if a tick was taken, 1 on timeout, -1 on error.
+     */
+    int simulith_client_wait_for_tick_timeout_r(simulith_client_t *client, uint64_t *tick_time_ns, int timeout_ms);
+
+    /**
+     * Get the edge-triggered readiness fd of the handle's tick socket.
+     *
+     * @param client Client handle.
+     * @param fd Receives the file descriptor.
+     * @return 0 on success, -1 on error.
+     */
+    int simulith_client_get_fd_r(const simulith_client_t *client, int *fd);
+
+    /**
+     * Copy the handle's timing statistics.
+     *
+     * @param client Client handle.
+     * @param stats Receives the statistics.
+     * @return 0 on success, -1 on error.
+     */
+    int simulith_client_get_stats_r(const simulith_client_t *client, simulith_client_stats_t *stats);
+
+    /**
+     * Clear the handle's timing statistics.
+     *
+     * @param client Client handle.
+     */
+    void simulith_client_reset_stats_r(simulith_client_t *client);
+
+    /**
+     * Report the last wait and callback times to the server in each ACK.
+     *
+     * @param client Client handle.
+     * @param enable Non-zero to report.
+     */
+    void simulith_client_set_stats_report_r(simulith_client_t *client, int enable);
+
+    /**
+     * Publish every tick the handle receives into a shared-memory clock.
+     *
+     * @param client Client handle.
+     * @param name Shared-memory object name, or NULL for a process-private clock.
+     * @return 0 on success, -1 on error.
+     */
+    int simulith_client_publish_clock_r(simulith_client_t *client, const char *name);
+
+    /**
+     * Get the clock the handle publishes into.
+     *
+     * @param client Client handle.
+     * @return Clock handle, NULL if the client does not publish one.
+     */
+    const simulith_clock_t *simulith_client_get_clock_r(const simulith_client_t *client);
+
+    /**
+     * Request a maximum step for the tick interval (see simulith_client_set_max_step).
+     *
+     * @param client Client handle.
+     * @param max_step_ns Largest acceptable interval in nanoseconds (0 clears the request).
+     */
+    void simulith_client_set_max_step_r(simulith_client_t *client, uint64_t max_step_ns);
+
+    /**
+     * Interval announced with the most recently received tick.
+     *
+     * @param client Client handle.
+     * @return Step from the last tick to the next in nanoseconds, 0 if no tick received.
+     */
+    uint64_t simulith_client_get_tick_interval_r(const simulith_client_t *client);
+
+    /**
+     * Shut down the client and free the handle.
+     *
+     * @param client Client handle.
+     */
+    void simulith_client_destroy(simulith_client_t *client);
+
 #ifdef __cplusplus
 }
 #endif
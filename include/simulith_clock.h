@@ -0,0 +1,82 @@
+#ifndef SIMULITH_CLOCK_H
+#define SIMULITH_CLOCK_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define SIMULITH_CLOCK_NAME "/simulith_clock" // Default shared-memory object name
+
+/**
+ * Shared-memory simulation clock. The process that receives ticks publishes each
+ * tick's sim time into a seqlock-protected page; any thread or process on the
+ * host maps the page and reads sim time with plain loads, no syscalls or locks.
+ */
+typedef struct simulith_clock simulith_clock_t;
+
+/**
+ * @brief Create (or take over) a clock for publishing
+ * @param name Shared-memory object name, e.g. SIMULITH_CLOCK_NAME, or NULL for
+ *             a clock private to this process
+ * @return Writable clock handle, NULL on failure
+ */
+simulith_clock_t* simulith_clock_create(const char* name);
+
+/**
+ * @brief Open an existing clock for reading
+ * @param name Shared-memory object name
+ * @return Read-only clock handle, NULL if the clock does not exist
+ */
+simulith_clock_t* simulith_clock_open(const char* name);
+
+/**
+ * @brief Publish a tick. Only one thread may publish to a clock.
+ * @param clock Writable clock handle
+ * @param time_ns Sim time of the tick in nanoseconds
+ * @param interval_ns Step to the next tick in nanoseconds
+ * @param speed Sim seconds per real second until the next tick, 0 to hold
+ * @return 0 on success, -1 on failure
+ */
+int simulith_clock_publish(simulith_clock_t* clock, uint64_t time_ns, uint64_t interval_ns, double speed);
+
+/**
+ * @brief Read a consistent snapshot of the clock
+ * @param clock Clock handle
+ * @param time_ns Receives the sim time of the latest tick (may be NULL)
+ * @param interval_ns Receives the step to the next tick (may be NULL)
+ * @param tick_seq Receives the number of ticks published (may be NULL)
+ * @return 0 on success, -1 on failure or if no tick has been published yet
+ */
+int simulith_clock_read(const simulith_clock_t* clock, uint64_t* time_ns, uint64_t* interval_ns, uint64_t* tick_seq);
+
+/**
+ * @brief Get the sim time of the latest tick
+ * @param clock Clock handle
+ * @return Sim time in nanoseconds, 0 before the first tick
+ */
+uint64_t simulith_clock_now_ns(const simulith_clock_t* clock);
+
+/**
+ * @brief Get sim time interpolated between ticks: the latest tick's time plus
+ * the real time elapsed since it was published (CLOCK_MONOTONIC) scaled by the
+ * announced speed, clamped so it never passes the next tick. Costs one seqlock
+ * read and one vDSO clock read.
+ * @param clock Clock handle
+ * @return Sim time in nanoseconds, 0 before the first tick
+ */
+uint64_t simulith_clock_interpolated_ns(const simulith_clock_t* clock);
+
+/**
+ * @brief Unmap the clock. A publisher also removes the name, so later opens
+ * fail while existing readers keep the last published time.
+ * @param clock Clock handle
+ */
+void simulith_clock_close(simulith_clock_t* clock);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SIMULITH_CLOCK_H */
@@ -9,6 +9,7 @@
 #include <math.h>
 #include <netdb.h>
 #include <netinet/in.h>
+#include <signal.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdint.h>
@@ -32,6 +33,7 @@ extern "C" {
 #define MAX_COMPONENTS 32
 #define MAX_COMPONENT_LIBS 32
 #define UDP_PUBLISH_INTERVAL_TICKS 10 // Publish every 10 ticks (assuming 100ms tick = 1s)
+#define TRANSPORT_STATS_INTERVAL_MS 60000 // Log transport port statistics every minute of sim time
 
 // Component registry entry
 typedef struct {
@@ -49,6 +51,7 @@ typedef struct
     int time_step_ms;
     int duration_s;
     int verbose;
+    int handshake_timeout_ms;
     
     // 42 integration
     int enable_42;
@@ -0,0 +1,119 @@
+#ifndef SIMULITH_GPIO_H
+#define SIMULITH_GPIO_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define SIMULITH_GPIO_NAME "/simulith_gpio" // Default shared-memory object name
+
+typedef struct {
+    int pin;
+    int direction; // 0=input to FSW, 1=output from FSW
+    int value;     // 0=low, 1=high
+} simulith_gpio_state_t;
+
+/**
+ * Shared-memory GPIO bank. Every pin is a few atomic words in one shared page,
+ * so reading or driving a pin is a plain load or store, with no socket traffic.
+ * Each level change bumps the pin's edge count and the bank's edge sequence;
+ * interrupt-style consumers block on the sequence (a futex) instead of polling.
+ */
+typedef struct simulith_gpio_bank simulith_gpio_bank_t;
+
+/**
+ * @brief Create (or take over) a bank with all pins low inputs
+ * @param name Shared-memory object name, e.g. SIMULITH_GPIO_NAME, or NULL for
+ *             a bank private to this process
+ * @param pin_count Number of pins
+ * @return Bank handle, NULL on failure
+ */
+simulith_gpio_bank_t* simulith_gpio_create(const char* name, unsigned int pin_count);
+
+/**
+ * @brief Open an existing bank. Both sides may drive pins.
+ * @param name Shared-memory object name
+ * @return Bank handle, NULL if the bank does not exist
+ */
+simulith_gpio_bank_t* simulith_gpio_open(const char* name);
+
+/**
+ * @brief Get the number of pins in a bank
+ * @param bank Bank handle
+ * @return Pin count, 0 for a NULL bank
+ */
+unsigned int simulith_gpio_pin_count(const simulith_gpio_bank_t* bank);
+
+/**
+ * @brief Drive a pin. A change of level counts as an edge and wakes waiters.
+ * @param bank Bank handle
+ * @param pin Pin number
+ * @param value 0 for low, anything else for high
+ * @return 0 on success, -1 on invalid arguments
+ */
+int simulith_gpio_write(simulith_gpio_bank_t* bank, unsigned int pin, int value);
+
+/**
+ * @brief Read a pin's level
+ * @param bank Bank handle
+ * @param pin Pin number
+ * @return 0 or 1, -1 on invalid arguments
+ */
+int simulith_gpio_read(const simulith_gpio_bank_t* bank, unsigned int pin);
+
+/**
+ * @brief Set which side drives a pin
+ * @param bank Bank handle
+ * @param pin Pin number
+ * @param direction 0 for input to FSW, 1 for output from FSW
+ * @return 0 on success, -1 on invalid arguments
+ */
+int simulith_gpio_set_direction(simulith_gpio_bank_t* bank, unsigned int pin, int direction);
+
+/**
+ * @brief Read a pin's number, direction and level
+ * @param bank Bank handle
+ * @param pin Pin number
+ * @param state Receives the pin state
+ * @return 0 on success, -1 on invalid arguments
+ */
+int simulith_gpio_get_state(const simulith_gpio_bank_t* bank, unsigned int pin, simulith_gpio_state_t* state);
+
+/**
+ * @brief Get the number of level changes on a pin since the bank was created.
+ * Compare with an earlier count to catch edges that were too short to see.
+ * @param bank Bank handle
+ * @param pin Pin number
+ * @return Edge count, 0 on invalid arguments
+ */
+uint32_t simulith_gpio_edges(const simulith_gpio_bank_t* bank, unsigned int pin);
+
+/**
+ * @brief Get the bank's edge sequence, to pass to simulith_gpio_wait_edge()
+ * @param bank Bank handle
+ * @return Number of edges on all pins, modulo 2^32
+ */
+uint32_t simulith_gpio_edge_seq(const simulith_gpio_bank_t* bank);
+
+/**
+ * @brief Block until any pin has an edge after *seq
+ * @param bank Bank handle
+ * @param seq In: the last sequence seen. Out: the current sequence.
+ * @param timeout_ms Longest wait in milliseconds, negative to wait forever
+ * @return 1 after an edge, 0 on timeout, -1 on invalid arguments
+ */
+int simulith_gpio_wait_edge(simulith_gpio_bank_t* bank, uint32_t* seq, int timeout_ms);
+
+/**
+ * @brief Unmap the bank. The creator also removes the name.
+ * @param bank Bank handle
+ */
+void simulith_gpio_close(simulith_gpio_bank_t* bank);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SIMULITH_GPIO_H */
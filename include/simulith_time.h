@@ -1,30 +1,92 @@
 #ifndef SIMULITH_TIME_H
 #define SIMULITH_TIME_H
 
+#include <stdint.h>
+
+#include "simulith_timer.h"
+
 #ifdef __cplusplus
 extern "C" {
 #endif
 
 /**
- * @brief Initialize the time provider
+ * @brief Initialize the time provider on LOCAL_PUB_ADDR
  * @return Handle to time provider, NULL on failure
  */
 void* simulith_time_init(void);
 
+/**
+ * @brief Initialize the time provider on a given tick publisher. Providers on
+ * the same address share a single subscription, so each task can cheaply have
+ * its own handle.
+ * @param pub_addr ZeroMQ address of the server's PUB socket
+ * @return Handle to time provider, NULL on failure
+ */
+void* simulith_time_init_addr(const char* pub_addr);
+
 /**
  * @brief Get current simulation time
  * @param handle Time provider handle
- * @return Current time in seconds
+ * @return Sim time of the latest tick in seconds
  */
 double simulith_time_get(void* handle);
 
 /**
- * @brief Wait for next time tick
+ * @brief Get simulation time interpolated between ticks. Advances with real
+ * time at the server's announced speed and never passes the next tick.
+ * @param handle Time provider handle
+ * @return Interpolated sim time in seconds
+ */
+double simulith_time_get_interpolated(void* handle);
+
+/**
+ * @brief Run a provider at a fraction of the tick rate
+ * @param handle Time provider handle
+ * @param divisor simulith_time_wait_for_next_tick() returns on every divisor-th
+ *                tick received by the process (1 = every tick, the default)
+ * @return 0 on success, -1 on failure
+ */
+int simulith_time_set_divisor(void* handle, unsigned int divisor);
+
+/**
+ * @brief Wait for next time tick, or the next tick due under the divisor
  * @param handle Time provider handle
  * @return 0 on success, -1 on failure
  */
 int simulith_time_wait_for_next_tick(void* handle);
 
+/**
+ * @brief Block until sim time reaches sim_time_ns. Any number of threads may
+ * sleep at once; one of them receives ticks and wakes only the threads whose
+ * deadline has passed.
+ * @param handle Time provider handle
+ * @param sim_time_ns Sim time to wake at in nanoseconds
+ * @return 0 on success, -1 on failure
+ */
+int simulith_time_sleep_until(void* handle, uint64_t sim_time_ns);
+
+/**
+ * @brief Arm a sim-time timer on the provider. Timers fire as ticks arrive,
+ * whether or not any thread is waiting: the first timer on a subscription
+ * starts a thread that receives ticks while no thread is blocked in
+ * simulith_time_sleep_until() or simulith_time_wait_for_next_tick().
+ * Callbacks run on whichever of these threads receives the tick and must not
+ * block or sleep.
+ * @param handle Time provider handle
+ * @param timer Timer initialised with simulith_timer_init()
+ * @param deadline_ns First expiry in sim time
+ * @param period_ns Repeat period, 0 for one-shot
+ * @return 0 on success, -1 on failure
+ */
+int simulith_time_timer_start(void* handle, simulith_timer_t* timer, uint64_t deadline_ns, uint64_t period_ns);
+
+/**
+ * @brief Cancel a timer armed with simulith_time_timer_start()
+ * @param handle Time provider handle
+ * @param timer Timer to cancel
+ */
+void simulith_time_timer_cancel(void* handle, simulith_timer_t* timer);
+
 /**
  * @brief Cleanup time provider
  * @param handle Time provider handle
@@ -0,0 +1,100 @@
+#ifndef SIMULITH_TIMER_H
+#define SIMULITH_TIMER_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Hierarchical timer wheel keyed on sim time. Four levels of 64 slots cover
+ * 64^4 resolution units (about 4.6 hours at 1 ms); later deadlines are parked
+ * in the top level and re-filed as time approaches. Advancing costs O(expired)
+ * plus one bitmap scan per 64 units, independent of the number of armed timers.
+ */
+typedef struct simulith_timer_wheel simulith_timer_wheel_t;
+
+/**
+ * Timer callback. Runs on the thread advancing the wheel, with the wheel locked;
+ * it may start or cancel timers but must not block or advance the wheel.
+ */
+typedef void (*simulith_timer_callback)(void* arg, uint64_t now_ns);
+
+/**
+ * Caller-owned timer. Initialise with simulith_timer_init(); the remaining
+ * fields are managed by the wheel.
+ */
+typedef struct simulith_timer
+{
+    simulith_timer_callback callback;
+    void*                   arg;
+    uint64_t                deadline_ns; // Next expiry in sim time
+    uint64_t                period_ns;   // 0 for a one-shot timer
+
+    uint64_t                expires;     // Deadline in wheel units
+    int                     bucket;      // Wheel slot, or -1 when not armed
+    struct simulith_timer*  next;
+    struct simulith_timer** pprev;
+} simulith_timer_t;
+
+/**
+ * @brief Create a timer wheel
+ * @param resolution_ns Granularity of deadlines; timers never fire early
+ * @return Wheel handle, NULL on failure
+ */
+simulith_timer_wheel_t* simulith_timer_wheel_create(uint64_t resolution_ns);
+
+/**
+ * @brief Destroy a wheel. Armed timers are dropped, not fired.
+ * @param wheel Wheel handle
+ */
+void simulith_timer_wheel_destroy(simulith_timer_wheel_t* wheel);
+
+/**
+ * @brief Fire every timer whose deadline is at or before now_ns
+ * @param wheel Wheel handle
+ * @param now_ns Current sim time in nanoseconds
+ * @return Number of timers fired, -1 on error
+ */
+int simulith_timer_wheel_advance(simulith_timer_wheel_t* wheel, uint64_t now_ns);
+
+/**
+ * @brief Initialise a timer
+ * @param timer Timer to initialise
+ * @param callback Function called on expiry
+ * @param arg Argument passed to the callback
+ */
+void simulith_timer_init(simulith_timer_t* timer, simulith_timer_callback callback, void* arg);
+
+/**
+ * @brief Arm (or re-arm) a timer. A periodic timer fires at deadline_ns and
+ * every period_ns after; periods missed by a large time step are skipped.
+ * @param wheel Wheel handle
+ * @param timer Initialised timer
+ * @param deadline_ns First expiry in sim time
+ * @param period_ns Repeat period, 0 for one-shot
+ * @return 0 on success, -1 on error
+ */
+int simulith_timer_start(simulith_timer_wheel_t* wheel, simulith_timer_t* timer, uint64_t deadline_ns,
+                         uint64_t period_ns);
+
+/**
+ * @brief Disarm a timer. Once this returns the callback will not run again.
+ * @param wheel Wheel handle
+ * @param timer Timer to cancel
+ */
+void simulith_timer_cancel(simulith_timer_wheel_t* wheel, simulith_timer_t* timer);
+
+/**
+ * @brief Check whether a timer is armed
+ * @param timer Timer
+ * @return 1 if armed, 0 otherwise
+ */
+int simulith_timer_is_armed(const simulith_timer_t* timer);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SIMULITH_TIMER_H */
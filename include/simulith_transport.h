@@ -11,12 +11,69 @@
 #define SIMULITH_TRANSPORT_SUCCESS 0
 #define SIMULITH_TRANSPORT_ERROR  -1
 #define SIMULITH_TRANSPORT_INITIALIZED 255
-#define SIMULITH_TRANSPORT_BUFFER_SIZE 4096
+#define SIMULITH_TRANSPORT_BUFFER_SIZE 4096 /* Default RX ring size */
+#define SIMULITH_TRANSPORT_MAX_FRAMES 128   /* Messages the RX ring can hold, a power of two */
+#define SIMULITH_TRANSPORT_CAPTURE_SNAPLEN 1024 /* Bytes of each message kept by a capture */
+
+/* Port modes */
+#define SIMULITH_TRANSPORT_PAIR       0 /* Point-to-point link (default) */
+#define SIMULITH_TRANSPORT_BUS_MASTER 1 /* Bus controller, e.g. the FSW I2C/SPI driver */
+#define SIMULITH_TRANSPORT_BUS_DEVICE 2 /* Device at bus_addr on a shared bus */
+
+/* Bus master messages start with the device address, big-endian: sent
+ * messages say which device they are for, received ones which device replied */
+#define SIMULITH_TRANSPORT_BUS_ADDR_LEN 2
+
+/* Header stamped ports put in front of every message */
+#define SIMULITH_TRANSPORT_STAMP_MAGIC 0x534d5453u /* "STMS" */
+typedef struct {
+    uint32_t magic;
+    uint32_t seq;    /* Counts every message the sender sent */
+    uint64_t sim_ns; /* Sender's sim time when it was sent */
+    uint64_t mono_ns; /* Sender's CLOCK_MONOTONIC when it was sent, for latency sampling */
+} simulith_transport_stamp_t;
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+/* Optional port settings for simulith_transport_init_config(). A zeroed
+ * config gives the defaults simulith_transport_init() uses. */
+typedef struct {
+    int mode;          /* SIMULITH_TRANSPORT_PAIR or a bus mode; bus ports always connect to a broker */
+    uint16_t bus_addr; /* Device address, for SIMULITH_TRANSPORT_BUS_DEVICE */
+    /* RX ring size, 0 for SIMULITH_TRANSPORT_BUFFER_SIZE; rounded up to a
+     * power of two */
+    size_t rx_buf_size;
+    /* Set above rx_buf_size to let the ring grow, doubling, up to this size
+     * when a message does not fit */
+    size_t rx_buf_max;
+    /* Hand messages still too big for the ring to the application in place,
+     * in order, instead of dropping them: receive() returns them in chunks,
+     * and rx_span() and borrow() lend them whole. Not for stamped or UART
+     * ports. */
+    int rx_stream;
+    /* Optional UART link model, enabled by a nonzero baud rate. Received bytes
+     * reach the application one byte time apart in sim time (see
+     * simulith_transport_set_time) and are lost when the RX FIFO is full. */
+    uint32_t uart_baud;
+    uint8_t uart_frame_bits; /* Bits per byte on the wire, 0 = 10 (8N1) */
+    size_t uart_fifo_depth;  /* RX FIFO size in bytes, 0 = limited by the RX ring only */
+    /* Optional sim time stamps, for point-to-point ports; both ends must set
+     * stamped. Received messages are held until the sim time reaches their
+     * send time plus delivery_delay_ns, so a receiver sees the same messages
+     * on the same tick on every run. A delay of one tick period is enough
+     * for anything sent during a tick to be delivered on the next. */
+    int stamped;
+    uint64_t delivery_delay_ns;
+    /* Sample the send-to-receive latency of every Nth stamped message, 0 = off.
+     * Uses CLOCK_MONOTONIC, so it is only meaningful between ports on one host. */
+    uint32_t latency_sample;
+} simulith_transport_config_t;
+
+/* RX ring, link model and counters of an initialised port */
+struct transport_port_state;
+
 typedef struct {
     char name[64];
     char address[128];
@@ -24,21 +81,111 @@ typedef struct {
     void* zmq_ctx;
     void* zmq_sock;
     int init;
-    /* RX buffer for incoming data */
-    uint8_t rx_buf[SIMULITH_TRANSPORT_BUFFER_SIZE];
-    size_t rx_buf_len;
+    struct transport_port_state *state; /* Private, allocated by init and freed by close */
 } transport_port_t;
 
+/* Traffic counters of one port. They are updated with relaxed atomics on the
+ * data path and may be read from any thread. */
+typedef struct {
+    uint64_t tx_msgs;
+    uint64_t tx_bytes;      /* Including stamp and bus address headers */
+    uint64_t tx_errors;     /* Failed sends and full reactor queues */
+    uint64_t rx_msgs;
+    uint64_t rx_bytes;
+    uint64_t rx_dropped;    /* Messages larger than the ring, or without a stamp */
+    uint64_t rx_overflows;  /* Times a message had to wait for room in the ring */
+    uint64_t rx_gaps;       /* Stamped messages that never arrived */
+    uint64_t uart_overruns; /* Bytes lost to a full UART FIFO */
+    uint64_t latency_samples;
+    uint64_t latency_mean_ns;
+    uint64_t latency_p99_ns;
+    uint64_t latency_max_ns;
+} simulith_transport_stats_t;
+
+typedef void (simulith_transport_stats_fn)(const char *name, const simulith_transport_stats_t *stats, void *ctx);
+
+/* A received message lent to the caller by simulith_transport_borrow() */
 typedef struct {
-    int pin;
-    int direction; // 0=input to FSW, 1=output from FSW
-    int value;     // 0=low, 1=high
-} simulith_gpio_state_t;
+    const uint8_t *data;
+    size_t len;
+    /* Private */
+    transport_port_t *port; /* Set when data points into the port's RX ring */
+    zmq_msg_t msg;
+    int has_msg;
+} simulith_transport_view_t;
 
+/* Routes bus master transactions to devices by address, see simulith_bus_broker_start() */
+typedef struct simulith_bus_broker simulith_bus_broker_t;
+
+/* Called once ZMQ is done with a buffer passed to simulith_transport_send_zc() */
+typedef void (simulith_transport_free_fn)(void *data, void *hint);
+
+/* Start one thread that polls every port initialised from now on and hands
+ * their messages over through lock-free queues, so checking a port for data
+ * costs an atomic load instead of a socket operation. Sends are queued to the
+ * thread too. Stop fails while ports are still attached; close them first. */
+int simulith_transport_reactor_start(void);
+int simulith_transport_reactor_stop(void);
+
+/* Advance the sim time link models run on; call once per tick */
+void simulith_transport_set_time(uint64_t sim_time_ns);
+
+/* Initialise a port with the default settings. Only name, address and
+ * is_server are read; everything else is set up by init. */
 int simulith_transport_init(transport_port_t *port);
+/* Initialise a port with the given settings, NULL for the defaults. Fails
+ * on settings out of range or that do not go together. */
+int simulith_transport_init_config(transport_port_t *port, const simulith_transport_config_t *config);
 int simulith_transport_send(transport_port_t *port, const uint8_t *data, size_t len);
 int simulith_transport_receive(transport_port_t *port, uint8_t *data, size_t max_len);
 int simulith_transport_available(transport_port_t *port);
+
+/* Copy up to max_len buffered bytes without consuming them */
+int simulith_transport_peek(transport_port_t *port, uint8_t *data, size_t max_len);
+/* Discard up to len buffered bytes; returns the number discarded */
+int simulith_transport_consume(transport_port_t *port, size_t len);
+/* Point *data at the longest contiguous run of buffered bytes and return its
+ * length, for parsing in place; follow with simulith_transport_consume() */
+int simulith_transport_rx_span(transport_port_t *port, const uint8_t **data);
+
+/* Borrow the next message without copying it into a caller buffer. Buffered
+ * data is returned first, then messages straight from the socket, which are
+ * not limited by the RX ring size. Returns 1 with view filled, 0 if nothing
+ * is pending. Release the view before the next call on the port; a ring
+ * that grows (rx_buf_max) moves. */
+int simulith_transport_borrow(transport_port_t *port, simulith_transport_view_t *view);
+void simulith_transport_release(simulith_transport_view_t *view);
+/* Send a caller-owned buffer without copying it. ffn(data, hint) is called
+ * once ZMQ no longer needs it, also when the send fails, possibly from a ZMQ
+ * I/O thread; the caller must not touch the buffer after this call. */
+int simulith_transport_send_zc(transport_port_t *port, uint8_t *data, size_t len, simulith_transport_free_fn *ffn, void *hint);
+
+/* Send a transaction from a bus master port to the device at addr */
+int simulith_transport_bus_send(transport_port_t *port, uint16_t addr, const uint8_t *data, size_t len);
+
+/* Start a broker bound at address, connecting one bus master port to any
+ * number of device ports. Device replies go to the master that last
+ * addressed them; messages for absent devices are dropped. */
+simulith_bus_broker_t *simulith_bus_broker_start(const char *address);
+void simulith_bus_broker_stop(simulith_bus_broker_t *broker);
+/* Read a port's counters */
+int simulith_transport_get_stats(const transport_port_t *port, simulith_transport_stats_t *stats);
+void simulith_transport_reset_stats(transport_port_t *port);
+/* Call fn with the counters of every initialised port in this process;
+ * returns the number of ports. fn must not init or close ports. */
+int simulith_transport_foreach_stats(simulith_transport_stats_fn *fn, void *ctx);
+
+/* Record the messages sent and received on ports initialised from now on to a
+ * pcapng file, one interface per port with the port's name and link type
+ * USER0 (147), stamped with sim time. filter is a comma-separated list of
+ * glob patterns for port names, NULL or "" for all. Frames are copied into a
+ * lock-free ring and written by a background thread; if it falls behind,
+ * frames are dropped rather than stalling the sim. Setting SIMULITH_CAPTURE
+ * to a path (and optionally SIMULITH_CAPTURE_FILTER) starts a capture on the
+ * first port init that runs until exit. */
+int simulith_transport_capture_start(const char *path, const char *filter);
+void simulith_transport_capture_stop(void);
+
 int simulith_transport_flush(transport_port_t *port);
 int simulith_transport_close(transport_port_t *port);
 
@@ -1,12 +1,194 @@
 #include "simulith.h"
+#include <errno.h>
+#include <inttypes.h>
+#include <signal.h>
 
-static void    *client_context = NULL;
-static void    *subscriber     = NULL;
-static void    *requester      = NULL;
-static char     client_id[64];
-static uint64_t update_rate_ns = 0;
+#define HANDSHAKE_TIMEOUT_MS     1000 // Default handshake deadline
+#define HANDSHAKE_BACKOFF_MIN_MS 5
+#define HANDSHAKE_BACKOFF_MAX_MS 250
+#define RECONNECT_IVL_MS         10   // Retry connecting to a server that is not up yet
+#define STOP_POLL_MS             100  // Longest the run loop waits before checking for a stop request
 
-int simulith_client_init(const char *pub_addr, const char *rep_addr, const char *id, uint64_t rate_ns)
+struct simulith_client
+{
+    void    *context;
+    void    *subscriber;
+    void    *requester;
+    char     id[64];
+    uint64_t update_rate_ns;
+    uint64_t max_step_ns;
+    uint64_t last_interval_ns;
+    uint64_t last_time_ns;
+    int      have_tick;
+    int      handshake_timeout_ms;
+    int      observer; // Receives ticks without joining the barrier
+    volatile sig_atomic_t stop_requested;
+
+    // Timing instrumentation
+    simulith_client_stats_t stats;
+    int      report_stats;     // Append the last wait/callback times to each ACK
+    uint64_t last_wait_ns;
+    uint64_t last_cb_ns;
+    uint64_t wait_start_ns;    // When the client started waiting for the next tick (0 = not waiting)
+    uint64_t tick_returned_ns; // When the last tick was handed to the caller
+
+    simulith_clock_t *clock; // Shared-memory clock fed with each tick (optional)
+};
+
+/* Instance behind the original single-client API */
+static simulith_client_t default_client;
+
+static uint64_t monotonic_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+static uint64_t monotonic_ms(void)
+{
+    return monotonic_ns() / 1000000ULL;
+}
+
+/* Receive the next new tick frame from the subscriber, skipping repeats of a tick
+ * already seen (the server re-publishes the first tick for late subscribers).
+ * Returns 0 on success, 1 if flags include ZMQ_DONTWAIT and no tick is queued, -1 on error. */
+static int receive_tick(simulith_client_t *client, simulith_tick_frame_t *frame, int flags)
+{
+    while (1)
+    {
+        uint8_t buf[sizeof(simulith_tick_frame_t)];
+        int     recv_bytes = zmq_recv(client->subscriber, buf, sizeof(buf), flags);
+        if (recv_bytes < 0)
+        {
+            return errno == EAGAIN ? 1 : -1;
+        }
+        size_t len = (size_t)recv_bytes < sizeof(buf) ? (size_t)recv_bytes : sizeof(buf);
+        if (simulith_tick_frame_decode(buf, len, frame) != 0)
+        {
+            return -1;
+        }
+        if (!client->have_tick || frame->time_ns > client->last_time_ns)
+        {
+            break;
+        }
+    }
+    client->have_tick        = 1;
+    client->last_time_ns     = frame->time_ns;
+    client->last_interval_ns = frame->interval_ns;
+    if (client->clock)
+    {
+        simulith_clock_publish(client->clock, frame->time_ns, frame->interval_ns, frame->speed);
+    }
+    return 0;
+}
+
+/* Send a request on the DEALER socket using the REQ envelope: [empty delimiter][body]. */
+static int send_request(simulith_client_t *client, const char *msg, size_t len, int flags)
+{
+    if (zmq_send(client->requester, "", 0, ZMQ_SNDMORE | flags) == -1)
+    {
+        return -1;
+    }
+    return zmq_send(client->requester, msg, len, flags) == -1 ? -1 : 0;
+}
+
+/* Receive a reply on the DEALER socket, skipping the empty delimiter. Returns the body size, or -1. */
+static int recv_reply(simulith_client_t *client, char *buf, size_t size)
+{
+    int rc = zmq_recv(client->requester, buf, size, 0);
+    if (rc == 0)
+    {
+        rc = zmq_recv(client->requester, buf, size, 0);
+    }
+    if (rc < 0)
+    {
+        return -1;
+    }
+    return rc < (int)size ? rc : (int)size;
+}
+
+/* Send the tick acknowledgment: the client ID, plus any requested max step.
+ * ACKs are asynchronous: the server does not reply and the next tick serves
+ * as confirmation, so a tick costs one traversal instead of a round trip. */
+static int send_ack(simulith_client_t *client)
+{
+    char ack[SIMULITH_ACK_MAX];
+    int  len;
+    if (client->max_step_ns > 0)
+    {
+        len = snprintf(ack, sizeof(ack), "%s step=%" PRIu64, client->id, client->max_step_ns);
+    }
+    else
+    {
+        len = snprintf(ack, sizeof(ack), "%s", client->id);
+    }
+    if (client->report_stats)
+    {
+        len += snprintf(ack + len, sizeof(ack) - (size_t)len, " wait=%" PRIu64 " cb=%" PRIu64, client->last_wait_ns,
+                        client->last_cb_ns);
+    }
+
+    uint64_t start_ns = monotonic_ns();
+    int      rc       = send_request(client, ack, (size_t)len, 0);
+    simulith_histogram_record(&client->stats.ack, monotonic_ns() - start_ns);
+    return rc;
+}
+
+/* Record the time spent blocked before a tick arrived. */
+static void record_wait(simulith_client_t *client, uint64_t now_ns)
+{
+    client->last_wait_ns  = client->wait_start_ns ? now_ns - client->wait_start_ns : 0;
+    client->wait_start_ns = 0;
+    simulith_histogram_record(&client->stats.wait, client->last_wait_ns);
+}
+
+/* Record the time spent processing a tick. */
+static void record_callback(simulith_client_t *client, uint64_t elapsed_ns)
+{
+    client->last_cb_ns = elapsed_ns;
+    simulith_histogram_record(&client->stats.callback, elapsed_ns);
+}
+
+static void client_close(simulith_client_t *client)
+{
+    if (client->subscriber)
+        zmq_close(client->subscriber);
+    if (client->requester)
+        zmq_close(client->requester);
+    if (client->context)
+        simulith_context_release();
+    simulith_clock_close(client->clock);
+    client->subscriber = NULL;
+    client->requester  = NULL;
+    client->context    = NULL;
+    client->clock      = NULL;
+}
+
+/* Connect the tick subscriber. Observers keep only the newest tick so they skip
+ * ahead instead of queueing when they fall behind. */
+static int open_subscriber(simulith_client_t *client, const char *pub_addr)
+{
+    int reconnect_ivl = RECONNECT_IVL_MS;
+    int conflate      = 1;
+    client->subscriber = zmq_socket(client->context, ZMQ_SUB);
+    if (client->subscriber)
+    {
+        zmq_setsockopt(client->subscriber, ZMQ_RECONNECT_IVL, &reconnect_ivl, sizeof(reconnect_ivl));
+        if (client->observer)
+            zmq_setsockopt(client->subscriber, ZMQ_CONFLATE, &conflate, sizeof(conflate));
+    }
+    if (!client->subscriber || zmq_connect(client->subscriber, pub_addr) != 0)
+    {
+        perror("Subscriber socket setup failed");
+        return -1;
+    }
+    zmq_setsockopt(client->subscriber, ZMQ_SUBSCRIBE, "", 0); // Subscribe to all messages
+    return 0;
+}
+
+static int client_open(simulith_client_t *client, const char *pub_addr, const char *rep_addr, const char *id,
+                       uint64_t rate_ns)
 {
     // Validate parameters
     if (!pub_addr || !rep_addr || !id)
@@ -27,68 +209,188 @@ int simulith_client_init(const char *pub_addr, const char *rep_addr, const char
         return -1;
     }
 
-    strncpy(client_id, id, sizeof(client_id) - 1);
-    client_id[sizeof(client_id) - 1] = '\0'; // Ensure null termination
-    update_rate_ns                   = rate_ns;
+    strncpy(client->id, id, sizeof(client->id) - 1);
+    client->id[sizeof(client->id) - 1] = '\0'; // Ensure null termination
+    client->update_rate_ns             = rate_ns;
+    client->max_step_ns                = 0;
+    client->last_interval_ns           = 0;
+    client->last_time_ns               = 0;
+    client->have_tick                  = 0;
+    client->handshake_timeout_ms       = HANDSHAKE_TIMEOUT_MS;
+    client->observer                   = 0;
+    client->report_stats               = 0;
+    client->wait_start_ns              = 0;
+    client->tick_returned_ns           = 0;
+    memset(&client->stats, 0, sizeof(client->stats));
 
-    client_context = zmq_ctx_new();
-    if (!client_context)
+    client->context = simulith_context_acquire();
+    if (!client->context)
     {
         perror("zmq_ctx_new failed");
         return -1;
     }
 
-    subscriber = zmq_socket(client_context, ZMQ_SUB);
-    if (!subscriber || zmq_connect(subscriber, pub_addr) != 0)
+    if (open_subscriber(client, pub_addr) != 0)
     {
-        perror("Subscriber socket setup failed");
+        client_close(client);
         return -1;
     }
-    zmq_setsockopt(subscriber, ZMQ_SUBSCRIBE, "", 0); // Subscribe to all messages
 
-    requester = zmq_socket(client_context, ZMQ_REQ);
-    if (!requester || zmq_connect(requester, rep_addr) != 0)
+    /* Only queue messages on completed connections, so a send that would block
+     * means the server is not reachable yet rather than a silently parked READY. */
+    int immediate     = 1;
+    int reconnect_ivl = RECONNECT_IVL_MS;
+    client->requester = zmq_socket(client->context, ZMQ_DEALER);
+    if (client->requester)
+    {
+        zmq_setsockopt(client->requester, ZMQ_IMMEDIATE, &immediate, sizeof(immediate));
+        zmq_setsockopt(client->requester, ZMQ_RECONNECT_IVL, &reconnect_ivl, sizeof(reconnect_ivl));
+    }
+    if (!client->requester || zmq_connect(client->requester, rep_addr) != 0)
     {
         perror("Requester socket setup failed");
+        client_close(client);
         return -1;
     }
-    
-    simulith_log("Simulith client [%s] initialized with update rate %lu ns\n", client_id, update_rate_ns);
+    int linger = 0; // Don't hold shutdown on ACKs the server will never read
+    zmq_setsockopt(client->requester, ZMQ_LINGER, &linger, sizeof(linger));
+
+    simulith_log("Simulith client [%s] initialized with update rate %" PRIu64 " ns\n", client->id, client->update_rate_ns);
     return 0;
 }
 
-int simulith_client_handshake(void)
+simulith_client_t *simulith_client_create(const char *pub_addr, const char *rep_addr, const char *id, uint64_t rate_ns)
 {
-    // Format READY message with client ID
-    char ready_msg[80];
-    snprintf(ready_msg, sizeof(ready_msg), "READY %s", client_id);
-    const char *ack_msg    = "ACK";
-    char        buffer[16] = {0};
+    simulith_client_t *client = calloc(1, sizeof(*client));
+    if (!client)
+    {
+        return NULL;
+    }
+    if (client_open(client, pub_addr, rep_addr, id, rate_ns) != 0)
+    {
+        free(client);
+        return NULL;
+    }
+    return client;
+}
+
+simulith_client_t *simulith_client_create_observer(const char *pub_addr, const char *id)
+{
+    if (!pub_addr || !id || strlen(id) == 0)
+    {
+        simulith_log("Invalid parameters: address and id cannot be NULL or empty\n");
+        return NULL;
+    }
 
-    // Set receive timeout to 1 second
-    int timeout = 1000; // milliseconds
-    zmq_setsockopt(requester, ZMQ_RCVTIMEO, &timeout, sizeof(timeout));
+    simulith_client_t *client = calloc(1, sizeof(*client));
+    if (!client)
+    {
+        return NULL;
+    }
+    strncpy(client->id, id, sizeof(client->id) - 1);
+    client->observer = 1;
 
-    // Send READY message with client ID
-    if (zmq_send(requester, ready_msg, strlen(ready_msg), 0) == -1)
+    client->context = simulith_context_acquire();
+    if (!client->context || open_subscriber(client, pub_addr) != 0)
+    {
+        client_close(client);
+        free(client);
+        return NULL;
+    }
+
+    simulith_log("Simulith observer [%s] initialized\n", client->id);
+    return client;
+}
+
+int simulith_client_handshake_r(simulith_client_t *client)
+{
+    if (!client)
     {
-        perror("Failed to send READY");
         return -1;
     }
 
-    // Wait for server response
-    int size = zmq_recv(requester, buffer, sizeof(buffer) - 1, 0);
-    if (size == -1)
+    // A restarted server counts time from zero again, so forget the last tick seen
+    client->have_tick    = 0;
+    client->last_time_ns = 0;
+
+    if (client->observer)
+    {
+        return 0; // Observers do not join the barrier
+    }
+    if (!client->requester)
+    {
+        return -1;
+    }
+
+    // Format READY message with client ID; ASYNC tells the server not to confirm tick ACKs
+    char ready_msg[96];
+    snprintf(ready_msg, sizeof(ready_msg), "READY %s ASYNC", client->id);
+    const char *ack_msg    = "ACK";
+    char        buffer[16] = {0};
+
+    /* Poll for the server with exponential backoff until the deadline. Waiting on
+     * POLLOUT returns as soon as the connection comes up; waiting on POLLIN returns
+     * as soon as the reply arrives. READY is re-sent after each quiet backoff in
+     * case it was lost to a server restart; the server treats repeats from the same
+     * connection as one registration. */
+    uint64_t deadline_ms = monotonic_ms() + (uint64_t)client->handshake_timeout_ms;
+    long     backoff_ms  = HANDSHAKE_BACKOFF_MIN_MS;
+    int      sent        = 0;
+    int      size        = -1;
+    while (size < 0)
     {
-        if (errno == EAGAIN)
+        uint64_t now_ms = monotonic_ms();
+        if (now_ms >= deadline_ms)
         {
             simulith_log("Handshake timeout - server not responding\n");
+            return -1;
         }
-        else
+        long wait_ms = (long)(deadline_ms - now_ms) < backoff_ms ? (long)(deadline_ms - now_ms) : backoff_ms;
+
+        if (!sent)
+        {
+            // Send READY message with client ID
+            if (send_request(client, ready_msg, strlen(ready_msg), ZMQ_DONTWAIT) == 0)
+            {
+                sent = 1;
+                continue;
+            }
+            if (errno != EAGAIN)
+            {
+                perror("Failed to send READY");
+                return -1;
+            }
+            zmq_pollitem_t items[] = { { client->requester, 0, ZMQ_POLLOUT, 0 } };
+            if (zmq_poll(items, 1, wait_ms) == 0 && backoff_ms < HANDSHAKE_BACKOFF_MAX_MS)
+            {
+                backoff_ms *= 2;
+            }
+            continue;
+        }
+
+        // Wait for server response
+        zmq_pollitem_t items[] = { { client->requester, 0, ZMQ_POLLIN, 0 } };
+        int rc = zmq_poll(items, 1, wait_ms);
+        if (rc < 0)
         {
             perror("Failed to receive ACK");
+            return -1;
+        }
+        if (rc == 0)
+        {
+            sent = 0;
+            if (backoff_ms < HANDSHAKE_BACKOFF_MAX_MS)
+            {
+                backoff_ms *= 2;
+            }
+            continue;
+        }
+        size = recv_reply(client, buffer, sizeof(buffer) - 1);
+        if (size == -1)
+        {
+            perror("Failed to receive ACK");
+            return -1;
         }
-        return -1;
     }
 
     buffer[size] = '\0';
@@ -96,7 +398,7 @@ int simulith_client_handshake(void)
     // Check for duplicate ID rejection
     if (strcmp(buffer, "DUP_ID") == 0)
     {
-        simulith_log("Handshake failed - duplicate client ID: %s\n", client_id);
+        simulith_log("Handshake failed - duplicate client ID: %s\n", client->id);
         return -1;
     }
 
@@ -107,75 +409,324 @@ int simulith_client_handshake(void)
         return -1;
     }
 
-    // Reset timeout to infinite for normal operation
-    timeout = -1;
-    zmq_setsockopt(requester, ZMQ_RCVTIMEO, &timeout, sizeof(timeout));
-
     simulith_log("Handshake complete with server.\n");
     return 0;
 }
 
-void simulith_client_run_loop(simulith_tick_callback on_tick)
+void simulith_client_set_handshake_timeout_r(simulith_client_t *client, int timeout_ms)
 {
-    while (1)
+    if (client && timeout_ms > 0)
+    {
+        client->handshake_timeout_ms = timeout_ms;
+    }
+}
+
+int simulith_client_run_loop_r(simulith_client_t *client, simulith_tick_callback on_tick)
+{
+    if (!client || !client->subscriber)
     {
-        uint64_t time_ns;
-        int      recv_bytes = zmq_recv(subscriber, &time_ns, sizeof(time_ns), 0);
-        if (recv_bytes == sizeof(time_ns))
+        return -1;
+    }
+
+    int result = 0;
+    client->wait_start_ns = monotonic_ns();
+    while (!client->stop_requested)
+    {
+        // Wait in bounded slices so a stop request is noticed without a tick
+        zmq_pollitem_t items[] = { { client->subscriber, 0, ZMQ_POLLIN, 0 } };
+        int            rc      = zmq_poll(items, 1, STOP_POLL_MS);
+        if (rc < 0 && errno != EINTR)
+        {
+            simulith_log("Client [%s] stopped: tick poll failed: %s\n", client->id, zmq_strerror(errno));
+            result = -1;
+            break;
+        }
+        if (rc <= 0)
+        {
+            continue;
+        }
+
+        simulith_tick_frame_t frame;
+        if (receive_tick(client, &frame, ZMQ_DONTWAIT) == 0)
         {
+            uint64_t received_ns = monotonic_ns();
+            record_wait(client, received_ns);
             if (on_tick)
             {
-                on_tick(time_ns);
+                on_tick(frame.time_ns);
             }
+            record_callback(client, monotonic_ns() - received_ns);
 
-            // Send acknowledgment - just send the client ID
-            char reply[16] = {0};
-            zmq_send(requester, client_id, strlen(client_id), 0);
-            zmq_recv(requester, reply, sizeof(reply) - 1, 0); // wait for server ACK
+            // Send acknowledgment; the next tick is the server's confirmation
+            if (!client->observer)
+            {
+                send_ack(client);
+            }
+            client->wait_start_ns = monotonic_ns();
         }
     }
+    client->wait_start_ns = 0;
+    client->stop_requested = 0;
+    return result;
 }
 
-int simulith_client_wait_for_tick(uint64_t* tick_time_ns)
+void simulith_client_stop_r(simulith_client_t *client)
+{
+    if (client)
+    {
+        client->stop_requested = 1;
+    }
+}
+
+/* Receive a tick (blocking or not, per flags) and acknowledge it. The caller
+ * processes a tick between calls, so that time is recorded as the callback time
+ * on the first call after a tick, and reported with the following ACK. */
+static int take_tick(simulith_client_t *client, uint64_t *tick_time_ns, int flags)
 {
-    if (!tick_time_ns || !subscriber || !requester)
+    if (!client || !tick_time_ns || !client->subscriber || (!client->requester && !client->observer))
     {
         return -1;
     }
 
+    if (!client->wait_start_ns)
+    {
+        client->wait_start_ns = monotonic_ns();
+        if (client->tick_returned_ns)
+        {
+            record_callback(client, client->wait_start_ns - client->tick_returned_ns);
+        }
+    }
+
     // Wait for next tick message
-    int recv_bytes = zmq_recv(subscriber, tick_time_ns, sizeof(*tick_time_ns), 0);
-    if (recv_bytes != sizeof(*tick_time_ns))
+    simulith_tick_frame_t frame;
+    int rc = receive_tick(client, &frame, flags);
+    if (rc != 0)
+    {
+        return rc;
+    }
+    *tick_time_ns = frame.time_ns;
+    record_wait(client, monotonic_ns());
+
+    // Send acknowledgment; the next tick is the server's confirmation
+    if (!client->observer && send_ack(client) != 0)
     {
         return -1;
     }
 
-    // Send acknowledgment - just send the client ID
-    if (zmq_send(requester, client_id, strlen(client_id), 0) == -1)
+    client->tick_returned_ns = monotonic_ns();
+    return 0;
+}
+
+int simulith_client_wait_for_tick_r(simulith_client_t *client, uint64_t *tick_time_ns)
+{
+    return take_tick(client, tick_time_ns, 0) == 0 ? 0 : -1;
+}
+
+int simulith_client_try_tick_r(simulith_client_t *client, uint64_t *tick_time_ns)
+{
+    return take_tick(client, tick_time_ns, ZMQ_DONTWAIT);
+}
+
+int simulith_client_wait_for_tick_timeout_r(simulith_client_t *client, uint64_t *tick_time_ns, int timeout_ms)
+{
+    if (!client || !client->subscriber)
     {
         return -1;
     }
 
-    // Wait for server ACK
-    char reply[16] = {0};
-    if (zmq_recv(requester, reply, sizeof(reply) - 1, 0) == -1)
+    uint64_t deadline_ms = monotonic_ms() + (uint64_t)(timeout_ms > 0 ? timeout_ms : 0);
+    while (1)
+    {
+        int rc = take_tick(client, tick_time_ns, ZMQ_DONTWAIT);
+        if (rc != 1)
+        {
+            return rc;
+        }
+
+        // Only a repeated tick may have been queued, so keep waiting until the deadline
+        uint64_t now_ms = monotonic_ms();
+        if (now_ms >= deadline_ms)
+        {
+            return 1;
+        }
+        zmq_pollitem_t items[] = { { client->subscriber, 0, ZMQ_POLLIN, 0 } };
+        if (zmq_poll(items, 1, (long)(deadline_ms - now_ms)) < 0)
+        {
+            return -1;
+        }
+    }
+}
+
+int simulith_client_get_stats_r(const simulith_client_t *client, simulith_client_stats_t *stats)
+{
+    if (!client || !stats)
     {
         return -1;
     }
+    *stats = client->stats;
+    return 0;
+}
+
+void simulith_client_reset_stats_r(simulith_client_t *client)
+{
+    if (client)
+    {
+        memset(&client->stats, 0, sizeof(client->stats));
+    }
+}
+
+void simulith_client_set_stats_report_r(simulith_client_t *client, int enable)
+{
+    if (client)
+    {
+        client->report_stats = enable;
+    }
+}
 
+int simulith_client_publish_clock_r(simulith_client_t *client, const char *name)
+{
+    if (!client || client->clock)
+    {
+        return -1;
+    }
+    client->clock = simulith_clock_create(name);
+    if (!client->clock)
+    {
+        return -1;
+    }
+    if (name)
+    {
+        simulith_log("Simulith client [%s] publishing sim time to %s\n", client->id, name);
+    }
     return 0;
 }
 
+const simulith_clock_t *simulith_client_get_clock_r(const simulith_client_t *client)
+{
+    return client ? client->clock : NULL;
+}
+
+int simulith_client_get_fd_r(const simulith_client_t *client, int *fd)
+{
+    if (!client || !client->subscriber || !fd)
+    {
+        return -1;
+    }
+    size_t fd_size = sizeof(*fd);
+    return zmq_getsockopt(client->subscriber, ZMQ_FD, fd, &fd_size) == 0 ? 0 : -1;
+}
+
+void simulith_client_set_max_step_r(simulith_client_t *client, uint64_t max_step_ns)
+{
+    if (client)
+    {
+        client->max_step_ns = max_step_ns;
+    }
+}
+
+uint64_t simulith_client_get_tick_interval_r(const simulith_client_t *client)
+{
+    return client ? client->last_interval_ns : 0;
+}
+
+void simulith_client_destroy(simulith_client_t *client)
+{
+    if (!client)
+    {
+        return;
+    }
+    client_close(client);
+    simulith_log("Simulith client [%s] shut down\n", client->id);
+    if (client != &default_client)
+    {
+        free(client);
+    }
+}
+
+// ---------- Default instance wrappers ----------
+
+int simulith_client_init(const char *pub_addr, const char *rep_addr, const char *id, uint64_t rate_ns)
+{
+    client_close(&default_client);
+    return client_open(&default_client, pub_addr, rep_addr, id, rate_ns);
+}
+
+int simulith_client_handshake(void)
+{
+    return simulith_client_handshake_r(&default_client);
+}
+
+void simulith_client_set_handshake_timeout(int timeout_ms)
+{
+    simulith_client_set_handshake_timeout_r(&default_client, timeout_ms);
+}
+
+int simulith_client_run_loop(simulith_tick_callback on_tick)
+{
+    return simulith_client_run_loop_r(&default_client, on_tick);
+}
+
+int simulith_client_wait_for_tick(uint64_t* tick_time_ns)
+{
+    return simulith_client_wait_for_tick_r(&default_client, tick_time_ns);
+}
+
+int simulith_client_try_tick(uint64_t *tick_time_ns)
+{
+    return simulith_client_try_tick_r(&default_client, tick_time_ns);
+}
+
+int simulith_client_wait_for_tick_timeout(uint64_t *tick_time_ns, int timeout_ms)
+{
+    return simulith_client_wait_for_tick_timeout_r(&default_client, tick_time_ns, timeout_ms);
+}
+
+int simulith_client_get_fd(int *fd)
+{
+    return simulith_client_get_fd_r(&default_client, fd);
+}
+
+int simulith_client_get_stats(simulith_client_stats_t *stats)
+{
+    return simulith_client_get_stats_r(&default_client, stats);
+}
+
+void simulith_client_reset_stats(void)
+{
+    simulith_client_reset_stats_r(&default_client);
+}
+
+void simulith_client_set_stats_report(int enable)
+{
+    simulith_client_set_stats_report_r(&default_client, enable);
+}
+
+int simulith_client_publish_clock(const char *name)
+{
+    return simulith_client_publish_clock_r(&default_client, name);
+}
+
+const simulith_clock_t *simulith_client_get_clock(void)
+{
+    return simulith_client_get_clock_r(&default_client);
+}
+
+void simulith_client_stop(void)
+{
+    simulith_client_stop_r(&default_client);
+}
+
+void simulith_client_set_max_step(uint64_t max_step_ns)
+{
+    simulith_client_set_max_step_r(&default_client, max_step_ns);
+}
+
+uint64_t simulith_client_get_tick_interval(void)
+{
+    return simulith_client_get_tick_interval_r(&default_client);
+}
+
 void simulith_client_shutdown(void)
 {
-    if (subscriber)
-        zmq_close(subscriber);
-    if (requester)
-        zmq_close(requester);
-    if (client_context)
-        zmq_ctx_term(client_context);
-    subscriber     = NULL;
-    requester      = NULL;
-    client_context = NULL;
-    simulith_log("Simulith client [%s] shut down\n", client_id);
+    simulith_client_destroy(&default_client);
 }
@@ -0,0 +1,213 @@
+/*
+ * Shared-memory sim clock. The page is a seqlock: the single writer makes the
+ * sequence odd, stores the fields and makes it even again; readers retry while
+ * the sequence is odd or changed under them. Every field is a lock-free atomic,
+ * so the page is safe to share between processes.
+ */
+
+#include "simulith.h"
+#include <stdatomic.h>
+#include <sys/mman.h>
+
+#define CLOCK_MAGIC   0x534d434cU // "SMCL"
+#define CLOCK_VERSION 2
+
+_Static_assert(ATOMIC_LLONG_LOCK_FREE == 2, "shared clock needs lock-free 64-bit atomics");
+
+typedef struct
+{
+    uint32_t         magic;
+    uint32_t         version;
+    _Atomic uint64_t seq; // Odd while a tick is being written; publishes = seq / 2
+    _Atomic uint64_t time_ns;
+    _Atomic uint64_t interval_ns;
+    _Atomic uint64_t speed_bits; // double
+    _Atomic uint64_t mono_ns;    // CLOCK_MONOTONIC when the tick was published
+} clock_page_t;
+
+typedef struct
+{
+    uint64_t seq;
+    uint64_t time_ns;
+    uint64_t interval_ns;
+    double   speed;
+    uint64_t mono_ns;
+} clock_snapshot_t;
+
+struct simulith_clock
+{
+    clock_page_t *page;
+    int           writer;
+    char          name[64]; // Empty for a process-private clock
+};
+
+static uint64_t monotonic_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+static simulith_clock_t *clock_map(const char *name, int flags)
+{
+    if (name && (name[0] != '/' || strlen(name) >= sizeof(((simulith_clock_t *)0)->name)))
+    {
+        simulith_log("Invalid clock name: %s\n", name);
+        return NULL;
+    }
+
+    size_t size = sizeof(clock_page_t);
+    void  *addr = simulith_shm_map(name, &size, flags);
+    if (!addr)
+    {
+        return NULL;
+    }
+
+    simulith_clock_t *clock = calloc(1, sizeof(*clock));
+    if (!clock)
+    {
+        simulith_shm_unmap(addr, size);
+        return NULL;
+    }
+    clock->page   = addr;
+    clock->writer = (flags & SIMULITH_SHM_CREATE) != 0;
+    if (name)
+    {
+        strcpy(clock->name, name);
+    }
+    return clock;
+}
+
+simulith_clock_t *simulith_clock_create(const char *name)
+{
+    simulith_clock_t *clock = clock_map(name, SIMULITH_SHM_CREATE);
+    if (!clock)
+    {
+        simulith_log("Failed to create clock %s\n", name ? name : "(null)");
+        return NULL;
+    }
+
+    // Start from a clean page even if a previous owner left one behind
+    clock_page_t *page = clock->page;
+    atomic_store_explicit(&page->seq, 0, memory_order_relaxed);
+    atomic_store_explicit(&page->time_ns, 0, memory_order_relaxed);
+    atomic_store_explicit(&page->interval_ns, 0, memory_order_relaxed);
+    atomic_store_explicit(&page->speed_bits, 0, memory_order_relaxed);
+    atomic_store_explicit(&page->mono_ns, 0, memory_order_relaxed);
+    page->version = CLOCK_VERSION;
+    atomic_thread_fence(memory_order_release);
+    page->magic = CLOCK_MAGIC;
+    return clock;
+}
+
+simulith_clock_t *simulith_clock_open(const char *name)
+{
+    if (!name)
+    {
+        return NULL;
+    }
+    simulith_clock_t *clock = clock_map(name, 0);
+    if (clock && (clock->page->magic != CLOCK_MAGIC || clock->page->version != CLOCK_VERSION))
+    {
+        simulith_log("Clock %s has an unknown layout\n", name);
+        simulith_clock_close(clock);
+        return NULL;
+    }
+    return clock;
+}
+
+int simulith_clock_publish(simulith_clock_t *clock, uint64_t time_ns, uint64_t interval_ns, double speed)
+{
+    if (!clock || !clock->writer)
+    {
+        return -1;
+    }
+
+    uint64_t speed_bits;
+    memcpy(&speed_bits, &speed, sizeof(speed_bits));
+    uint64_t mono_ns = monotonic_ns();
+
+    clock_page_t *page = clock->page;
+    uint64_t      seq  = atomic_load_explicit(&page->seq, memory_order_relaxed);
+    atomic_store_explicit(&page->seq, seq + 1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+    atomic_store_explicit(&page->time_ns, time_ns, memory_order_relaxed);
+    atomic_store_explicit(&page->interval_ns, interval_ns, memory_order_relaxed);
+    atomic_store_explicit(&page->speed_bits, speed_bits, memory_order_relaxed);
+    atomic_store_explicit(&page->mono_ns, mono_ns, memory_order_relaxed);
+    atomic_store_explicit(&page->seq, seq + 2, memory_order_release);
+    return 0;
+}
+
+/* Read a consistent copy of the page. Returns -1 before the first tick. */
+static int clock_snapshot(const simulith_clock_t *clock, clock_snapshot_t *snap)
+{
+    clock_page_t *page = clock->page;
+    uint64_t      speed_bits;
+    do
+    {
+        snap->seq         = atomic_load_explicit(&page->seq, memory_order_acquire);
+        snap->time_ns     = atomic_load_explicit(&page->time_ns, memory_order_relaxed);
+        snap->interval_ns = atomic_load_explicit(&page->interval_ns, memory_order_relaxed);
+        speed_bits        = atomic_load_explicit(&page->speed_bits, memory_order_relaxed);
+        snap->mono_ns     = atomic_load_explicit(&page->mono_ns, memory_order_relaxed);
+        atomic_thread_fence(memory_order_acquire);
+    } while ((snap->seq & 1) || snap->seq != atomic_load_explicit(&page->seq, memory_order_relaxed));
+
+    memcpy(&snap->speed, &speed_bits, sizeof(snap->speed));
+    return snap->seq == 0 ? -1 : 0;
+}
+
+int simulith_clock_read(const simulith_clock_t *clock, uint64_t *time_ns, uint64_t *interval_ns, uint64_t *tick_seq)
+{
+    clock_snapshot_t snap;
+    if (!clock || clock_snapshot(clock, &snap) != 0)
+    {
+        return -1;
+    }
+    if (time_ns)
+        *time_ns = snap.time_ns;
+    if (interval_ns)
+        *interval_ns = snap.interval_ns;
+    if (tick_seq)
+        *tick_seq = snap.seq / 2;
+    return 0;
+}
+
+uint64_t simulith_clock_interpolated_ns(const simulith_clock_t *clock)
+{
+    clock_snapshot_t snap;
+    if (!clock || clock_snapshot(clock, &snap) != 0)
+    {
+        return 0;
+    }
+    if (!(snap.speed > 0.0))
+    {
+        return snap.time_ns;
+    }
+
+    uint64_t now_ns = monotonic_ns();
+    double   ahead  = (double)(now_ns > snap.mono_ns ? now_ns - snap.mono_ns : 0) * snap.speed;
+    return snap.time_ns + (ahead < (double)snap.interval_ns ? (uint64_t)ahead : snap.interval_ns);
+}
+
+uint64_t simulith_clock_now_ns(const simulith_clock_t *clock)
+{
+    uint64_t time_ns = 0;
+    simulith_clock_read(clock, &time_ns, NULL, NULL);
+    return time_ns;
+}
+
+void simulith_clock_close(simulith_clock_t *clock)
+{
+    if (!clock)
+    {
+        return;
+    }
+    if (clock->writer && clock->name[0])
+    {
+        shm_unlink(clock->name);
+    }
+    simulith_shm_unmap(clock->page, sizeof(clock_page_t));
+    free(clock);
+}
@@ -3,6 +3,9 @@
 #include <stdlib.h>
 #include <string.h>
 #include <stdarg.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 
 typedef enum {
     LOG_MODE_STDOUT,
@@ -84,6 +87,103 @@ void simulith_log(const char *fmt, ...)
     }
 }
 
+int simulith_tick_frame_decode(const void *buf, size_t len, simulith_tick_frame_t *frame)
+{
+    if (!buf || !frame || len < sizeof(frame->time_ns)) {
+        return -1;
+    }
+    memcpy(&frame->time_ns, buf, sizeof(frame->time_ns));
+    const uint8_t *p = (const uint8_t *)buf;
+    if (len >= offsetof(simulith_tick_frame_t, speed)) {
+        memcpy(&frame->interval_ns, p + offsetof(simulith_tick_frame_t, interval_ns), sizeof(frame->interval_ns));
+    } else {
+        frame->interval_ns = INTERVAL_NS;
+    }
+    if (len >= sizeof(*frame)) {
+        memcpy(&frame->speed, p + offsetof(simulith_tick_frame_t, speed), sizeof(frame->speed));
+    } else {
+        frame->speed = 1.0;
+    }
+    return 0;
+}
+
+void simulith_histogram_record(simulith_histogram_t *hist, uint64_t ns)
+{
+    int bucket = ns ? 63 - __builtin_clzll(ns) : 0;
+    if (bucket >= SIMULITH_HIST_BUCKETS) {
+        bucket = SIMULITH_HIST_BUCKETS - 1;
+    }
+    hist->buckets[bucket]++;
+    hist->count++;
+    hist->total_ns += ns;
+    if (ns > hist->max_ns) {
+        hist->max_ns = ns;
+    }
+}
+
+uint64_t simulith_histogram_percentile(const simulith_histogram_t *hist, double percentile)
+{
+    if (!hist || hist->count == 0) {
+        return 0;
+    }
+    uint64_t rank = (uint64_t)((percentile / 100.0) * (double)hist->count + 0.5);
+    if (rank == 0) {
+        rank = 1;
+    }
+    uint64_t seen = 0;
+    for (int i = 0; i < SIMULITH_HIST_BUCKETS - 1; ++i) {
+        seen += hist->buckets[i];
+        if (seen >= rank) {
+            uint64_t upper = 2ULL << i;
+            return upper < hist->max_ns ? upper : hist->max_ns;
+        }
+    }
+    return hist->max_ns;
+}
+
+void *simulith_shm_map(const char *name, size_t *size, int flags)
+{
+    void *addr;
+    if (!size) {
+        return NULL;
+    }
+    if (!name) {
+        if (*size == 0) {
+            return NULL;
+        }
+        addr = mmap(NULL, *size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+        return addr == MAP_FAILED ? NULL : addr;
+    }
+
+    int writable = flags & (SIMULITH_SHM_CREATE | SIMULITH_SHM_WRITE);
+    int fd = shm_open(name, (writable ? O_RDWR : O_RDONLY) | ((flags & SIMULITH_SHM_CREATE) ? O_CREAT : 0), 0644);
+    if (fd < 0) {
+        return NULL;
+    }
+    if ((flags & SIMULITH_SHM_CREATE) && (*size == 0 || ftruncate(fd, (off_t)*size) != 0)) {
+        close(fd);
+        return NULL;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || (size_t)st.st_size < *size || st.st_size == 0) {
+        close(fd);
+        return NULL;
+    }
+    if (*size == 0) {
+        *size = (size_t)st.st_size;
+    }
+    addr = mmap(NULL, *size, writable ? (PROT_READ | PROT_WRITE) : PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    return addr == MAP_FAILED ? NULL : addr;
+}
+
+void simulith_shm_unmap(void *addr, size_t size)
+{
+    if (addr) {
+        munmap(addr, size);
+    }
+}
+
 #ifdef SIMULITH_TESTING
 /* Test-only helper: reset logging to uninitialized state and close any open
  * log file. Tests should call this between cases to avoid cross-test
@@ -0,0 +1,126 @@
+/*
+ * Process-wide ZMQ context shared by every Simulith socket: clients, time
+ * providers, transport ports and the server. One context means one set of I/O
+ * threads and one reaper per process instead of one per port.
+ */
+
+#include "simulith.h"
+#include <pthread.h>
+
+static pthread_mutex_t context_lock   = PTHREAD_MUTEX_INITIALIZER;
+static void           *context        = NULL;
+static int             refcount       = 0;
+static int             io_threads     = 0; // 0 = from environment or ZMQ default
+static uint64_t        cpu_mask       = 0; // 0 = no affinity
+static int             configured     = 0;
+
+/* Parse a CPU list such as "0,2,3" into a bitmask of CPUs 0..63 */
+static uint64_t parse_cpu_list(const char *list)
+{
+    uint64_t mask = 0;
+    while (list && *list)
+    {
+        char *end;
+        long  cpu = strtol(list, &end, 10);
+        if (end == list)
+            break;
+        if (cpu >= 0 && cpu < 64)
+            mask |= 1ULL << cpu;
+        list = (*end == ',') ? end + 1 : end;
+    }
+    return mask;
+}
+
+static void apply_settings(void *ctx)
+{
+    int      threads = io_threads;
+    uint64_t mask    = cpu_mask;
+
+    if (!configured)
+    {
+        const char *env = getenv("SIMULITH_IO_THREADS");
+        if (env)
+            threads = atoi(env);
+        env = getenv("SIMULITH_IO_AFFINITY");
+        if (env)
+            mask = parse_cpu_list(env);
+    }
+
+    if (threads > 0)
+    {
+        zmq_ctx_set(ctx, ZMQ_IO_THREADS, threads);
+    }
+    if (mask)
+    {
+#ifdef ZMQ_THREAD_AFFINITY_CPU_ADD
+        for (int cpu = 0; cpu < 64; ++cpu)
+        {
+            if (mask & (1ULL << cpu))
+                zmq_ctx_set(ctx, ZMQ_THREAD_AFFINITY_CPU_ADD, cpu);
+        }
+#else
+        simulith_log("simulith_context: I/O thread affinity not supported by this libzmq\n");
+#endif
+    }
+}
+
+int simulith_context_configure(int threads, uint64_t affinity_mask)
+{
+    if (threads < 0)
+    {
+        simulith_log("simulith_context_configure: Invalid I/O thread count %d\n", threads);
+        return -1;
+    }
+
+    pthread_mutex_lock(&context_lock);
+    if (context)
+    {
+        pthread_mutex_unlock(&context_lock);
+        simulith_log("simulith_context_configure: Context already in use\n");
+        return -1;
+    }
+    io_threads = threads;
+    cpu_mask   = affinity_mask;
+    configured = 1;
+    pthread_mutex_unlock(&context_lock);
+    return 0;
+}
+
+void *simulith_context_acquire(void)
+{
+    pthread_mutex_lock(&context_lock);
+    if (!context)
+    {
+        context = zmq_ctx_new();
+        if (context)
+        {
+            apply_settings(context);
+        }
+    }
+    if (context)
+    {
+        refcount++;
+    }
+    void *ctx = context;
+    pthread_mutex_unlock(&context_lock);
+    return ctx;
+}
+
+void simulith_context_release(void)
+{
+    void *last = NULL;
+    pthread_mutex_lock(&context_lock);
+    if (refcount > 0 && --refcount == 0)
+    {
+        last    = context;
+        context = NULL;
+    }
+    pthread_mutex_unlock(&context_lock);
+
+    // Terminating blocks until every socket is closed, possibly by a thread
+    // that still needs the lock to release its own reference
+    if (last)
+    {
+        zmq_ctx_term(last);
+    }
+}
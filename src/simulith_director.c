@@ -28,6 +28,7 @@ director_config_t g_director_config;
 static int g_udp_sock = -1;
 static struct sockaddr_in g_udp_addr;
 static int g_udp_publish_counter = 0;
+static uint64_t g_transport_stats_last_ns = 0; // Sim time of the last stats log
 static int g_backdoor_sock = -1;
 
 static int ensure_backdoor_socket(void)
@@ -118,6 +119,7 @@ int parse_args(int argc, char *argv[], director_config_t *config)
     config->time_step_ms = 100;  // 100ms default
     config->duration_s = 0;      // Run indefinitely 
     config->verbose = 0;
+    config->handshake_timeout_ms = 30000;  // Allow the server time to come up
     config->enable_42 = 1;       // Enable 42 by default now that we have the correct path
     config->fortytwo_initialized = 0;
     
@@ -131,11 +133,14 @@ int parse_args(int argc, char *argv[], director_config_t *config)
             printf("42 config directory set to: %s\n", config->fortytwo_config);
         } else if (strcmp(argv[i], "--verbose") == 0) {
             config->verbose = 1;
+        } else if (strcmp(argv[i], "--handshake-timeout") == 0 && i + 1 < argc) {
+            config->handshake_timeout_ms = atoi(argv[++i]);
         } else if (strcmp(argv[i], "--help") == 0) {
             printf("Simulith Director Options:\n");
             printf("  --enable-42        Enable 42 dynamics simulation\n");
             printf("  --42-config DIR    Set 42 configuration directory (default: ./InOut)\n");
             printf("  --verbose          Enable verbose output\n");
+            printf("  --handshake-timeout MS  Wait up to MS for the Simulith server (default: 30000)\n");
             printf("  --help             Show this help message\n");
             return -1;  // Exit after showing help
         }
@@ -509,8 +514,37 @@ static void process_42_commands(void)
     }
 }
 
+static void print_port_stats(const char* name, const simulith_transport_stats_t* stats, void* ctx)
+{
+    (void)ctx;
+    printf("  %-24s tx %llu msgs %llu B %llu err | rx %llu msgs %llu B %llu dropped %llu overflows %llu gaps %llu overruns",
+           name, (unsigned long long)stats->tx_msgs, (unsigned long long)stats->tx_bytes,
+           (unsigned long long)stats->tx_errors, (unsigned long long)stats->rx_msgs,
+           (unsigned long long)stats->rx_bytes, (unsigned long long)stats->rx_dropped,
+           (unsigned long long)stats->rx_overflows, (unsigned long long)stats->rx_gaps,
+           (unsigned long long)stats->uart_overruns);
+    if (stats->latency_samples)
+    {
+        printf(" | latency mean %llu p99 %llu max %llu ns", (unsigned long long)stats->latency_mean_ns,
+               (unsigned long long)stats->latency_p99_ns, (unsigned long long)stats->latency_max_ns);
+    }
+    printf("\n");
+}
+
+static void log_transport_stats(void)
+{
+    printf("Transport port statistics:\n");
+    if (simulith_transport_foreach_stats(print_port_stats, NULL) == 0)
+    {
+        printf("  (no open ports)\n");
+    }
+}
+
 void on_tick(uint64_t tick_time_ns)
 {
+    // Link models deliver bytes on sim time
+    simulith_transport_set_time(tick_time_ns);
+
     // Populate 42 context for this tick
     simulith_42_context_t context_42;
     populate_42_context(&context_42);
@@ -538,6 +572,15 @@ void on_tick(uint64_t tick_time_ns)
     // Service backdoor packets
     process_backdoor_once(&g_director_config);
 
+    // Saturated or lossy links show up here without verbose logging; timed in
+    // sim time since the tick interval can change from step to step
+    if (tick_time_ns < g_transport_stats_last_ns ||
+        tick_time_ns - g_transport_stats_last_ns >= TRANSPORT_STATS_INTERVAL_MS * 1000000ULL)
+    {
+        g_transport_stats_last_ns = tick_time_ns;
+        log_transport_stats();
+    }
+
     // Publish telemetry
     g_udp_publish_counter = (g_udp_publish_counter + 1) % UDP_PUBLISH_INTERVAL_TICKS;
     if (g_udp_sock >= 0 && context_42.valid && g_udp_publish_counter == 0)
@@ -580,6 +623,13 @@ void on_tick(uint64_t tick_time_ns)
     }
 }
 
+// Let the tick loop return so components are cleaned up on Ctrl-C or docker stop
+static void handle_stop_signal(int sig)
+{
+    (void)sig;
+    simulith_client_stop();
+}
+
 int main(int argc, char *argv[]) 
 {
     printf("Simulith Director starting...\n");
@@ -638,9 +688,6 @@ int main(int argc, char *argv[])
         }
     }
 
-    // Wait a second for the Simulith server to start up
-    sleep(1);
-
     if (simulith_client_init(LOCAL_PUB_ADDR, LOCAL_REP_ADDR, "tryspace-director", INTERVAL_NS) != 0) 
     {
         printf("Failed to initialize Simulith client\n");
@@ -648,6 +695,9 @@ int main(int argc, char *argv[])
         return 1;
     }
 
+    // The handshake polls for the server, so no fixed startup delay is needed
+    simulith_client_set_handshake_timeout(g_director_config.handshake_timeout_ms);
+
     // Handshake with Simulith server
     if (simulith_client_handshake() != 0) 
     {
@@ -657,9 +707,13 @@ int main(int argc, char *argv[])
         return 1;
     }
 
+    signal(SIGINT, handle_stop_signal);
+    signal(SIGTERM, handle_stop_signal);
+
     simulith_client_run_loop(on_tick);
     
     printf("Simulith director shutting down...\n");
+    log_transport_stats();
     
     // Cleanup
     simulith_client_shutdown();
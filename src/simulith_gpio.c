@@ -0,0 +1,301 @@
+/*
+ * Shared-memory GPIO bank. The page holds a header and one slot per pin; every
+ * field that changes after creation is a lock-free 32-bit atomic, so the page
+ * is safe to share between processes. Writers bump the bank's edge sequence on
+ * every level change and only enter the kernel to wake waiters when some are
+ * blocked on it.
+ */
+
+#include "simulith.h"
+#include <errno.h>
+#include <limits.h>
+#include <linux/futex.h>
+#include <stdatomic.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+
+#define GPIO_MAGIC   0x534d4750U // "SMGP"
+#define GPIO_VERSION 1
+
+_Static_assert(ATOMIC_INT_LOCK_FREE == 2, "shared GPIO bank needs lock-free 32-bit atomics");
+
+typedef struct
+{
+    _Atomic uint32_t value;
+    _Atomic uint32_t direction;
+    _Atomic uint32_t edges;
+    uint32_t         reserved;
+} gpio_pin_t;
+
+typedef struct
+{
+    uint32_t         magic;
+    uint32_t         version;
+    uint32_t         pin_count;
+    _Atomic uint32_t edge_seq; // Futex word
+    _Atomic uint32_t waiters;
+    uint32_t         reserved[3];
+    gpio_pin_t       pins[];
+} gpio_page_t;
+
+struct simulith_gpio_bank
+{
+    gpio_page_t *page;
+    size_t       size;
+    int          owner;
+    char         name[64]; // Empty for a process-private bank
+};
+
+static long futex(_Atomic uint32_t *addr, int op, uint32_t val, const struct timespec *timeout)
+{
+    // Not FUTEX_PRIVATE_FLAG: waiters and wakers may be in different processes
+    return syscall(SYS_futex, (uint32_t *)addr, op, val, timeout, NULL, 0);
+}
+
+static simulith_gpio_bank_t *gpio_map(const char *name, size_t size, int flags)
+{
+    if (name && (name[0] != '/' || strlen(name) >= sizeof(((simulith_gpio_bank_t *)0)->name)))
+    {
+        simulith_log("Invalid GPIO bank name: %s\n", name);
+        return NULL;
+    }
+
+    void *addr = simulith_shm_map(name, &size, flags);
+    if (!addr)
+    {
+        return NULL;
+    }
+
+    simulith_gpio_bank_t *bank = calloc(1, sizeof(*bank));
+    if (!bank)
+    {
+        simulith_shm_unmap(addr, size);
+        return NULL;
+    }
+    bank->page  = addr;
+    bank->size  = size;
+    bank->owner = (flags & SIMULITH_SHM_CREATE) != 0;
+    if (name)
+    {
+        strcpy(bank->name, name);
+    }
+    return bank;
+}
+
+static gpio_pin_t *gpio_pin(const simulith_gpio_bank_t *bank, unsigned int pin)
+{
+    if (!bank || pin >= bank->page->pin_count)
+    {
+        return NULL;
+    }
+    return &bank->page->pins[pin];
+}
+
+simulith_gpio_bank_t *simulith_gpio_create(const char *name, unsigned int pin_count)
+{
+    if (pin_count == 0 || pin_count > 65536)
+    {
+        simulith_log("Invalid GPIO pin count: %u\n", pin_count);
+        return NULL;
+    }
+
+    simulith_gpio_bank_t *bank = gpio_map(name, sizeof(gpio_page_t) + pin_count * sizeof(gpio_pin_t),
+                                          SIMULITH_SHM_CREATE);
+    if (!bank)
+    {
+        simulith_log("Failed to create GPIO bank %s\n", name ? name : "(null)");
+        return NULL;
+    }
+
+    // Start from a clean page even if a previous owner left one behind
+    gpio_page_t *page = bank->page;
+    page->magic       = 0;
+    atomic_thread_fence(memory_order_release);
+    for (unsigned int i = 0; i < pin_count; ++i)
+    {
+        atomic_store_explicit(&page->pins[i].value, 0, memory_order_relaxed);
+        atomic_store_explicit(&page->pins[i].direction, 0, memory_order_relaxed);
+        atomic_store_explicit(&page->pins[i].edges, 0, memory_order_relaxed);
+    }
+    atomic_store_explicit(&page->edge_seq, 0, memory_order_relaxed);
+    atomic_store_explicit(&page->waiters, 0, memory_order_relaxed);
+    page->pin_count = pin_count;
+    page->version   = GPIO_VERSION;
+    atomic_thread_fence(memory_order_release);
+    page->magic = GPIO_MAGIC;
+    return bank;
+}
+
+simulith_gpio_bank_t *simulith_gpio_open(const char *name)
+{
+    if (!name)
+    {
+        return NULL;
+    }
+    simulith_gpio_bank_t *bank = gpio_map(name, 0, SIMULITH_SHM_WRITE);
+    if (!bank)
+    {
+        return NULL;
+    }
+    gpio_page_t *page = bank->page;
+    if (bank->size < sizeof(gpio_page_t) || page->magic != GPIO_MAGIC || page->version != GPIO_VERSION ||
+        bank->size < sizeof(gpio_page_t) + page->pin_count * sizeof(gpio_pin_t))
+    {
+        simulith_log("GPIO bank %s has an unknown layout\n", name);
+        simulith_gpio_close(bank);
+        return NULL;
+    }
+    return bank;
+}
+
+unsigned int simulith_gpio_pin_count(const simulith_gpio_bank_t *bank)
+{
+    return bank ? bank->page->pin_count : 0;
+}
+
+int simulith_gpio_write(simulith_gpio_bank_t *bank, unsigned int pin, int value)
+{
+    gpio_pin_t *p = gpio_pin(bank, pin);
+    if (!p)
+    {
+        return -1;
+    }
+
+    uint32_t level = value ? 1 : 0;
+    if (atomic_exchange_explicit(&p->value, level, memory_order_acq_rel) == level)
+    {
+        return 0;
+    }
+    atomic_fetch_add_explicit(&p->edges, 1, memory_order_release);
+    // Sequentially consistent with the waiter's registration, so either it
+    // sees the new sequence or we see it waiting
+    atomic_fetch_add(&bank->page->edge_seq, 1);
+    if (atomic_load(&bank->page->waiters) > 0)
+    {
+        futex(&bank->page->edge_seq, FUTEX_WAKE, INT_MAX, NULL);
+    }
+    return 0;
+}
+
+int simulith_gpio_read(const simulith_gpio_bank_t *bank, unsigned int pin)
+{
+    gpio_pin_t *p = gpio_pin(bank, pin);
+    if (!p)
+    {
+        return -1;
+    }
+    return (int)atomic_load_explicit(&p->value, memory_order_acquire);
+}
+
+int simulith_gpio_set_direction(simulith_gpio_bank_t *bank, unsigned int pin, int direction)
+{
+    gpio_pin_t *p = gpio_pin(bank, pin);
+    if (!p)
+    {
+        return -1;
+    }
+    atomic_store_explicit(&p->direction, direction ? 1 : 0, memory_order_release);
+    return 0;
+}
+
+int simulith_gpio_get_state(const simulith_gpio_bank_t *bank, unsigned int pin, simulith_gpio_state_t *state)
+{
+    gpio_pin_t *p = gpio_pin(bank, pin);
+    if (!p || !state)
+    {
+        return -1;
+    }
+    state->pin       = (int)pin;
+    state->direction = (int)atomic_load_explicit(&p->direction, memory_order_acquire);
+    state->value     = (int)atomic_load_explicit(&p->value, memory_order_acquire);
+    return 0;
+}
+
+uint32_t simulith_gpio_edges(const simulith_gpio_bank_t *bank, unsigned int pin)
+{
+    gpio_pin_t *p = gpio_pin(bank, pin);
+    return p ? atomic_load_explicit(&p->edges, memory_order_acquire) : 0;
+}
+
+uint32_t simulith_gpio_edge_seq(const simulith_gpio_bank_t *bank)
+{
+    return bank ? atomic_load_explicit(&bank->page->edge_seq, memory_order_acquire) : 0;
+}
+
+int simulith_gpio_wait_edge(simulith_gpio_bank_t *bank, uint32_t *seq, int timeout_ms)
+{
+    if (!bank || !seq)
+    {
+        return -1;
+    }
+
+    gpio_page_t    *page = bank->page;
+    struct timespec deadline;
+    clock_gettime(CLOCK_MONOTONIC, &deadline);
+    if (timeout_ms >= 0)
+    {
+        deadline.tv_sec += timeout_ms / 1000;
+        deadline.tv_nsec += (long)(timeout_ms % 1000) * 1000000L;
+        if (deadline.tv_nsec >= 1000000000L)
+        {
+            deadline.tv_sec++;
+            deadline.tv_nsec -= 1000000000L;
+        }
+    }
+
+    int rc = 0;
+    atomic_fetch_add(&page->waiters, 1);
+    for (;;)
+    {
+        uint32_t now = atomic_load(&page->edge_seq);
+        if (now != *seq)
+        {
+            *seq = now;
+            rc   = 1;
+            break;
+        }
+
+        struct timespec  left;
+        struct timespec *timeout = NULL;
+        if (timeout_ms >= 0)
+        {
+            struct timespec ts;
+            clock_gettime(CLOCK_MONOTONIC, &ts);
+            left.tv_sec  = deadline.tv_sec - ts.tv_sec;
+            left.tv_nsec = deadline.tv_nsec - ts.tv_nsec;
+            if (left.tv_nsec < 0)
+            {
+                left.tv_sec--;
+                left.tv_nsec += 1000000000L;
+            }
+            if (left.tv_sec < 0)
+            {
+                break;
+            }
+            timeout = &left;
+        }
+        // Returns at once if the sequence moved since it was loaded
+        if (futex(&page->edge_seq, FUTEX_WAIT, now, timeout) != 0 && errno == ETIMEDOUT)
+        {
+            *seq = atomic_load(&page->edge_seq);
+            rc   = *seq != now;
+            break;
+        }
+    }
+    atomic_fetch_sub(&page->waiters, 1);
+    return rc;
+}
+
+void simulith_gpio_close(simulith_gpio_bank_t *bank)
+{
+    if (!bank)
+    {
+        return;
+    }
+    if (bank->owner && bank->name[0])
+    {
+        shm_unlink(bank->name);
+    }
+    simulith_shm_unmap(bank->page, bank->size);
+    free(bank);
+}
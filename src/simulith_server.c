@@ -1,13 +1,40 @@
 #include "simulith.h"
+#include <inttypes.h>
 #include <sched.h>
 #include <signal.h>
 
 #define MAX_CLIENTS 32
 
+#define SPEED_MIN 0.015625
+#define SPEED_MAX 1024.0
+
+#define ROUTING_ID_MAX 256
+
+/* Re-publish the first tick until every client has it, covering subscribers that
+ * connected just after their handshake completed. */
+#define FIRST_TICK_RETRANSMIT_NS 50000000ULL // 50ms
+
+/* Requester envelope on the ROUTER socket: routing id of the REQ/DEALER peer */
+typedef struct
+{
+    uint8_t id[ROUTING_ID_MAX];
+    size_t  id_len;
+} RequestEnvelope;
+
 typedef struct
 {
-    char id[64];
-    int  responded;
+    char     id[64];
+    int      responded;
+    uint64_t max_step_ns; // Largest step this client accepts (0 = no request)
+    int      async_ack;   // ACKs are not confirmed; the next tick is the confirmation
+    RequestEnvelope peer; // Connection the client registered from
+
+    // Timing reported in ACKs since the last status log
+    uint64_t reports;
+    uint64_t wait_ns_total;
+    uint64_t wait_ns_max;
+    uint64_t cb_ns_total;
+    uint64_t cb_ns_max;
 } ClientState;
 
 static void       *server_context             = NULL;
@@ -15,12 +42,34 @@ static void       *publisher                  = NULL;
 static void       *responder                  = NULL;
 static uint64_t    current_time_ns            = 0;
 static uint64_t    tick_interval_ns           = 0;
+static uint64_t    interval_min_ns            = 0;
+static uint64_t    interval_max_ns            = 0;
+static uint64_t    step_ns                    = 0; // Interval announced in the current tick frame
 static int         expected_clients           = 0;
 static ClientState client_states[MAX_CLIENTS] = {0};
 
 /* Test/debug helper: request server shutdown from other threads. */
 static volatile sig_atomic_t simulith_server_stop_requested = 0;
 
+/* Pre-roll schedule: run unthrottled until preroll_until_ns, then continue at preroll_speed. */
+static int      preroll_active   = 0;
+static uint64_t preroll_until_ns = 0;
+static double   preroll_speed    = 1.0;
+
+/* A client retrying READY on the same connection is already registered, not a duplicate. */
+static int is_repeated_ready(const char *id, const RequestEnvelope *env)
+{
+    for (int i = 0; i < MAX_CLIENTS; ++i)
+    {
+        if (client_states[i].id[0] != '\0' && strcmp(client_states[i].id, id) == 0)
+        {
+            return client_states[i].peer.id_len == env->id_len &&
+                   memcmp(client_states[i].peer.id, env->id, env->id_len) == 0;
+        }
+    }
+    return 0;
+}
+
 static int is_client_id_taken(const char *id)
 {
     for (int i = 0; i < MAX_CLIENTS; ++i)
@@ -34,6 +83,20 @@ static int is_client_id_taken(const char *id)
     return 0;
 }
 
+/* Close server sockets and drop the shared context reference. */
+static void close_sockets(void)
+{
+    if (publisher)
+        zmq_close(publisher);
+    if (responder)
+        zmq_close(responder);
+    if (server_context)
+        simulith_context_release();
+    publisher      = NULL;
+    responder      = NULL;
+    server_context = NULL;
+}
+
 int simulith_server_init(const char *pub_bind, const char *rep_bind, int client_count, uint64_t interval_ns)
 {
     /* Clear any previous stop request so a fresh server run isn't short-circuited. */
@@ -54,8 +117,14 @@ int simulith_server_init(const char *pub_bind, const char *rep_bind, int client_
 
     expected_clients = client_count;
     tick_interval_ns = interval_ns;
-
-    server_context = zmq_ctx_new();
+    interval_min_ns  = interval_ns;
+    interval_max_ns  = interval_ns;
+    step_ns          = interval_ns;
+    preroll_active   = 0;
+    preroll_until_ns = 0;
+    preroll_speed    = 1.0;
+
+    server_context = simulith_context_acquire();
     if (!server_context)
     {
         perror("zmq_ctx_new failed");
@@ -66,6 +135,7 @@ int simulith_server_init(const char *pub_bind, const char *rep_bind, int client_
     if (!publisher || zmq_bind(publisher, pub_bind) != 0)
     {
         perror("Publisher socket setup failed");
+        close_sockets();
         return -1;
     }
 
@@ -75,10 +145,13 @@ int simulith_server_init(const char *pub_bind, const char *rep_bind, int client_
     zmq_setsockopt(publisher, ZMQ_SNDHWM, &sndhwm, sizeof(sndhwm));
     zmq_setsockopt(publisher, ZMQ_LINGER, &linger, sizeof(linger));
 
-    responder = zmq_socket(server_context, ZMQ_REP);
+    /* ROUTER rather than REP so DEALER clients can ACK without waiting for a
+     * reply, while REQ clients still get one. */
+    responder = zmq_socket(server_context, ZMQ_ROUTER);
     if (!responder || zmq_bind(responder, rep_bind) != 0)
     {
         perror("Responder socket setup failed");
+        close_sockets();
         return -1;
     }
 
@@ -94,11 +167,7 @@ int simulith_server_init(const char *pub_bind, const char *rep_bind, int client_
     zmq_setsockopt(responder, ZMQ_LINGER, &linger, sizeof(linger));
 
     // Initialize client states
-    for (int i = 0; i < MAX_CLIENTS; ++i)
-    {
-        client_states[i].id[0]     = '\0';
-        client_states[i].responded = 0;
-    }
+    memset(client_states, 0, sizeof(client_states));
 
     simulith_log("Simulith server initialized. Clients expected: %d\n", expected_clients);
     return 0;
@@ -106,34 +175,200 @@ int simulith_server_init(const char *pub_bind, const char *rep_bind, int client_
 
 // Global for speed tracking
 static double g_attempted_speed = 1.0;
+static uint64_t g_last_log_sim_ns = 0;
 static uint64_t g_last_log_real_ns = 0;
 
+static uint64_t monotonic_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+static void publish_tick(void)
+{
+    // Pre-roll runs as fast as clients allow, so there is no rate to interpolate with
+    simulith_tick_frame_t frame = { current_time_ns, step_ns, preroll_active ? 0.0 : g_attempted_speed };
+    zmq_send(publisher, &frame, sizeof(frame), 0);
+}
+
+/* Summarise the timing clients reported since the last log and start a new window. */
+static void log_client_timing(void)
+{
+    for (int i = 0; i < expected_clients; ++i)
+    {
+        ClientState *c = &client_states[i];
+        if (c->reports == 0)
+            continue;
+
+        simulith_log("    %s: wait avg %.3f ms max %.3f ms | callback avg %.3f ms max %.3f ms\n", c->id,
+                     (double)c->wait_ns_total / (double)c->reports / 1e6, (double)c->wait_ns_max / 1e6,
+                     (double)c->cb_ns_total / (double)c->reports / 1e6, (double)c->cb_ns_max / 1e6);
+        c->reports       = 0;
+        c->wait_ns_total = 0;
+        c->wait_ns_max   = 0;
+        c->cb_ns_total   = 0;
+        c->cb_ns_max     = 0;
+    }
+}
+
 static void broadcast_time(void)
 {
-    static uint64_t last_log_time = 0;
     static const uint64_t LOG_INTERVAL_NS = 10000000000; // Log every 10 seconds
 
-    zmq_send(publisher, &current_time_ns, sizeof(current_time_ns), 0);
+    publish_tick();
 
     // Only log time broadcasts every LOG_INTERVAL_NS
-    if (current_time_ns - last_log_time >= LOG_INTERVAL_NS) 
+    if (current_time_ns - g_last_log_sim_ns >= LOG_INTERVAL_NS) 
     {
         // Calculate actual speed (sim seconds per real second)
-        struct timespec now_ts;
-        clock_gettime(CLOCK_MONOTONIC, &now_ts);
-        uint64_t now_real_ns = (uint64_t)now_ts.tv_sec * 1000000000ULL + (uint64_t)now_ts.tv_nsec;
-        double sim_elapsed = (double)(current_time_ns - last_log_time) / 1e9;
+        uint64_t now_real_ns = monotonic_ns();
+        double sim_elapsed = (double)(current_time_ns - g_last_log_sim_ns) / 1e9;
         double real_elapsed = (g_last_log_real_ns > 0) ? ((double)(now_real_ns - g_last_log_real_ns) / 1e9) : 0.0;
         double actual_speed = (real_elapsed > 0.0) ? (sim_elapsed / real_elapsed) : 0.0;
 
-        simulith_log("  Simulation time: %.3f seconds | Attempted speed: %.2fx | Actual: %.2fx\n",
-            (double)current_time_ns / 1e9, g_attempted_speed, actual_speed);
+        if (preroll_active)
+        {
+            simulith_log("  Simulation time: %.3f seconds | Pre-roll to %.3f seconds (unthrottled) | Actual: %.2fx\n",
+                (double)current_time_ns / 1e9, (double)preroll_until_ns / 1e9, actual_speed);
+        }
+        else
+        {
+            simulith_log("  Simulation time: %.3f seconds | Attempted speed: %.2fx | Actual: %.2fx\n",
+                (double)current_time_ns / 1e9, g_attempted_speed, actual_speed);
+        }
 
-        last_log_time = current_time_ns;
+        log_client_timing();
+
+        g_last_log_sim_ns = current_time_ns;
         g_last_log_real_ns = now_real_ns;
     }
 }
 
+int simulith_server_set_interval_limits(uint64_t min_ns, uint64_t max_ns)
+{
+    if (min_ns == 0 || min_ns > max_ns)
+    {
+        simulith_log("Invalid interval limits: %" PRIu64 "..%" PRIu64 " ns\n", min_ns, max_ns);
+        return -1;
+    }
+
+    interval_min_ns = min_ns;
+    interval_max_ns = max_ns;
+    simulith_log("Tick interval limits set to %" PRIu64 "..%" PRIu64 " ns\n", min_ns, max_ns);
+    return 0;
+}
+
+/* Next step is the smallest maximum requested by any client, bounded by the
+ * configured limits. Clients that made no request accept the base interval. */
+static uint64_t choose_next_interval(void)
+{
+    uint64_t next = interval_max_ns;
+    for (int i = 0; i < expected_clients; ++i)
+    {
+        uint64_t requested = client_states[i].max_step_ns ? client_states[i].max_step_ns : tick_interval_ns;
+        if (requested < next)
+            next = requested;
+    }
+    if (next < interval_min_ns)
+        next = interval_min_ns;
+    return next;
+}
+
+int simulith_server_set_preroll(uint64_t until_ns, double speed)
+{
+    if (speed < SPEED_MIN || speed > SPEED_MAX)
+    {
+        simulith_log("Invalid pre-roll speed: %.4f (must be between %.4f and %.1f)\n", speed, SPEED_MIN, SPEED_MAX);
+        return -1;
+    }
+
+    preroll_until_ns = until_ns;
+    preroll_speed    = speed;
+    preroll_active   = (until_ns > current_time_ns);
+    if (preroll_active)
+    {
+        simulith_log("Pre-roll scheduled: unthrottled until %.3f seconds, then %.4fx\n", (double)until_ns / 1e9, speed);
+    }
+    return 0;
+}
+
+/* End the pre-roll: switch to the scheduled speed and re-anchor the pacing base at
+ * the current sim time so the first paced tick does not try to make up for the
+ * unthrottled run. Returns the new speed. */
+static double finish_preroll(void)
+{
+    preroll_active     = 0;
+    g_attempted_speed  = preroll_speed;
+    g_last_log_sim_ns  = current_time_ns;
+    g_last_log_real_ns = monotonic_ns();
+    printf("Pre-roll complete at %.3f seconds. Attempted simulation speed: %.4fx\n",
+           (double)current_time_ns / 1e9, preroll_speed);
+    return preroll_speed;
+}
+
+/* Handle one CLI command line. Returns 0 to keep running, -1 to quit. */
+static int handle_cli_command(const char *cmd, int *paused, double *speed)
+{
+    if (strncmp(cmd, "p", 1) == 0) 
+    {
+        *paused = !*paused;
+        printf(*paused ? "Simulation paused.\n" : "Simulation resumed.\n");
+    } else if (strncmp(cmd, "+", 1) == 0) 
+    {
+        *speed *= 2.0;
+        if (*speed > SPEED_MAX) *speed = SPEED_MAX;
+        g_attempted_speed = *speed;
+        printf("Attempted simulation speed: %.2fx\n", *speed);
+    } else if (strncmp(cmd, "-", 1) == 0) 
+    {
+        *speed /= 2.0;
+        if (*speed < SPEED_MIN) *speed = SPEED_MIN;
+        g_attempted_speed = *speed;
+        printf("Attempted simulation speed: %.4fx\n", *speed);
+    } else if (strncmp(cmd, "ff", 2) == 0) 
+    {
+        // ff <sim_seconds> [speed]: run unthrottled until sim time, then continue at speed
+        double until_s = 0.0;
+        double after_speed = *speed;
+        if (sscanf(cmd + 2, "%lf %lf", &until_s, &after_speed) < 1 || until_s < 0.0 ||
+            simulith_server_set_preroll((uint64_t)(until_s * 1e9), after_speed) != 0)
+        {
+            printf("Usage: ff <sim_seconds> [speed]\n");
+        } else if (!preroll_active)
+        {
+            *speed = finish_preroll();
+        }
+    } else if (strncmp(cmd, "quit", 4) == 0) 
+    {
+        printf("Exiting simulation.\n");
+        return -1;
+    } else 
+    {
+        printf("Unknown command. Use 'p', '+', '-', or 'ff <sim_seconds> [speed]'.\n");
+    }
+    return 0;
+}
+
+/* Non-blocking check of stdin for a CLI command. Returns 0 to keep running, -1 to quit. */
+static int poll_cli(int *paused, double *speed)
+{
+    fd_set readfds;
+    struct timeval tv;
+    char cli_buf[32];
+
+    FD_ZERO(&readfds);
+    FD_SET(0, &readfds); // stdin
+    tv.tv_sec = 0;
+    tv.tv_usec = 0;
+    int cli_ready = select(1, &readfds, NULL, NULL, &tv);
+    if (cli_ready > 0 && FD_ISSET(0, &readfds) && fgets(cli_buf, sizeof(cli_buf), stdin)) 
+    {
+        return handle_cli_command(cli_buf, paused, speed);
+    }
+    return 0;
+}
+
 static int all_clients_responded(void)
 {
     int count = 0;
@@ -153,17 +388,98 @@ static void reset_responses(void)
     }
 }
 
-static void handle_ack(const char *client_id)
+/* Receive one request from the ROUTER socket. Both REQ and DEALER clients send
+ * [empty delimiter][body]; the ROUTER prepends the routing id. The body is
+ * NUL-terminated and truncated to fit. Returns the body length, or -1. */
+static int recv_request(int flags, RequestEnvelope *env, char *body, size_t body_size)
+{
+    int id_len = zmq_recv(responder, env->id, sizeof(env->id), flags);
+    if (id_len < 0)
+        return -1;
+    env->id_len = (size_t)id_len < sizeof(env->id) ? (size_t)id_len : sizeof(env->id);
+
+    int size = -1;
+    int more = 1;
+    while (more)
+    {
+        size_t more_size = sizeof(more);
+        if (size < 0)
+        {
+            // Skip the empty delimiter; the first non-empty frame is the body
+            int rc = zmq_recv(responder, body, body_size - 1, 0);
+            if (rc < 0)
+                return -1;
+            if (rc > 0)
+            {
+                size = rc < (int)body_size - 1 ? rc : (int)body_size - 1;
+                body[size] = '\0';
+            }
+        }
+        else
+        {
+            // Discard anything trailing the body
+            char discard[16];
+            if (zmq_recv(responder, discard, sizeof(discard), 0) < 0)
+                return -1;
+        }
+        if (zmq_getsockopt(responder, ZMQ_RCVMORE, &more, &more_size) != 0)
+            more = 0;
+    }
+    return size < 0 ? 0 : size;
+}
+
+static void send_reply(const RequestEnvelope *env, const char *reply)
 {
+    zmq_send(responder, env->id, env->id_len, ZMQ_SNDMORE);
+    zmq_send(responder, "", 0, ZMQ_SNDMORE);
+    zmq_send(responder, reply, strlen(reply), 0);
+}
+
+/* ACK format: "<client_id>[ step=<max_step_ns>]". Returns the client slot, or -1 if unknown. */
+static int handle_ack(char *ack)
+{
+    char *fields    = strchr(ack, ' ');
+    const char *client_id = ack;
+    if (fields)
+        *fields++ = '\0';
+
     for (int i = 0; i < expected_clients; ++i)
     {
         if (client_states[i].id[0] != '\0' && strcmp(client_states[i].id, client_id) == 0)
         {
-            client_states[i].responded = 1;
-            return;
+            ClientState *c = &client_states[i];
+            c->responded   = 1;
+            c->max_step_ns = 0; // An ACK without "step=" clears the request
+
+            // Optional fields: "step=<ns>", and "wait=<ns> cb=<ns>" timing reports
+            uint64_t value    = 0;
+            int      reported = 0;
+            char    *save     = NULL;
+            for (char *tok = fields ? strtok_r(fields, " ", &save) : NULL; tok; tok = strtok_r(NULL, " ", &save))
+            {
+                if (sscanf(tok, "step=%" SCNu64, &value) == 1)
+                {
+                    c->max_step_ns = value;
+                }
+                else if (sscanf(tok, "wait=%" SCNu64, &value) == 1)
+                {
+                    c->wait_ns_total += value;
+                    c->wait_ns_max = value > c->wait_ns_max ? value : c->wait_ns_max;
+                    reported       = 1;
+                }
+                else if (sscanf(tok, "cb=%" SCNu64, &value) == 1)
+                {
+                    c->cb_ns_total += value;
+                    c->cb_ns_max = value > c->cb_ns_max ? value : c->cb_ns_max;
+                    reported     = 1;
+                }
+            }
+            c->reports += (uint64_t)reported;
+            return i;
         }
     }
     simulith_log("ACK received from unknown client: %s\n", client_id);
+    return -1;
 }
 
 void simulith_server_run(void)
@@ -179,27 +495,40 @@ void simulith_server_run(void)
             return;
         }
 
-        char buffer[64] = {0};
-        int  size       = zmq_recv(responder, buffer, sizeof(buffer) - 1, 0);
+        RequestEnvelope env;
+        char buffer[96] = {0};
+        int  size       = recv_request(0, &env, buffer, sizeof(buffer));
         if (size > 0)
         {
-            buffer[size] = '\0';
-
-            // Parse READY message
+            // Parse READY message: "READY <client_id>[ ASYNC]"
             char *space = strchr(buffer, ' ');
             if (!space || strncmp(buffer, "READY", 5) != 0)
             {
                 simulith_log("Invalid handshake message: %s\n", buffer);
-                zmq_send(responder, "ERR", 3, 0);
+                send_reply(&env, "ERR");
                 continue;
             }
 
-            // Extract client ID (skip "READY " prefix)
+            // Extract client ID (skip "READY " prefix) and options
             char *client_id = space + 1;
+            int   async_ack = 0;
+            char *options   = strchr(client_id, ' ');
+            if (options)
+            {
+                *options++ = '\0';
+                async_ack  = (strcmp(options, "ASYNC") == 0);
+            }
             if (strlen(client_id) == 0)
             {
                 simulith_log("Empty client ID in handshake\n");
-                zmq_send(responder, "ERR", 3, 0);
+                send_reply(&env, "ERR");
+                continue;
+            }
+
+            // Acknowledge handshake retries again without registering twice
+            if (is_repeated_ready(client_id, &env))
+            {
+                send_reply(&env, "ACK");
                 continue;
             }
 
@@ -207,7 +536,7 @@ void simulith_server_run(void)
             if (is_client_id_taken(client_id))
             {
                 simulith_log("Rejecting duplicate client ID: %s\n", client_id);
-                zmq_send(responder, "DUP_ID", 6, 0);
+                send_reply(&env, "DUP_ID");
                 continue;
             }
 
@@ -225,7 +554,7 @@ void simulith_server_run(void)
             if (slot == -1)
             {
                 simulith_log("No available slots for new client\n");
-                zmq_send(responder, "ERR", 3, 0);
+                send_reply(&env, "ERR");
                 continue;
             }
 
@@ -233,9 +562,12 @@ void simulith_server_run(void)
             strncpy(client_states[slot].id, client_id, sizeof(client_states[slot].id) - 1);
             client_states[slot].id[sizeof(client_states[slot].id) - 1] = '\0';
             client_states[slot].responded                              = 0;
+            client_states[slot].max_step_ns                            = 0;
+            client_states[slot].async_ack                              = async_ack;
+            client_states[slot].peer                                   = env;
             ready_clients++;
 
-            zmq_send(responder, "ACK", 3, 0);
+            send_reply(&env, "ACK");
             simulith_log("Registered client %s (%d/%d)\n", client_id, ready_clients, expected_clients);
         }
         else
@@ -264,50 +596,25 @@ void simulith_server_run(void)
     int running = 1;
     double speed = 1.0; // 1.0 = real time
     g_attempted_speed = speed;
-    fd_set readfds;
-    struct timeval tv;
-    char cli_buf[32];
+    g_last_log_sim_ns = current_time_ns;
+    g_last_log_real_ns = 0;
+
+    int first_tick = 1;
 
-    printf("Simulith CLI started. Type 'p' (pause/play), '+' (faster), or '-' (slower).\n");
+    printf("Simulith CLI started. Type 'p' (pause/play), '+' (faster), '-' (slower), or 'ff <sim_seconds> [speed]' (fast-forward).\n");
+
+    if (preroll_active && current_time_ns >= preroll_until_ns)
+    {
+        speed = finish_preroll();
+    }
 
-    while (running)
+    while (running && !simulith_server_stop_requested)
     {
         // Check for CLI input (non-blocking)
-        FD_ZERO(&readfds);
-        FD_SET(0, &readfds); // stdin
-        tv.tv_sec = 0;
-        tv.tv_usec = 0;
-        int cli_ready = select(1, &readfds, NULL, NULL, &tv);
-        if (cli_ready > 0 && FD_ISSET(0, &readfds)) 
+        if (poll_cli(&paused, &speed) != 0)
         {
-            if (fgets(cli_buf, sizeof(cli_buf), stdin)) 
-            {
-                if (strncmp(cli_buf, "p", 1) == 0) 
-                {
-                    paused = !paused;
-                    printf(paused ? "Simulation paused.\n" : "Simulation resumed.\n");
-                } else if (strncmp(cli_buf, "+", 1) == 0) 
-                {
-                    speed *= 2.0;
-                    if (speed > 1024.0) speed = 1024.0;
-                    g_attempted_speed = speed;
-                    printf("Attempted simulation speed: %.2fx\n", speed);
-                } else if (strncmp(cli_buf, "-", 1) == 0) 
-                {
-                    speed /= 2.0;
-                    if (speed < 0.015625) speed = 0.015625;
-                    g_attempted_speed = speed;
-                    printf("Attempted simulation speed: %.4fx\n", speed);
-                } else if (strncmp(cli_buf, "quit", 4) == 0) 
-                {
-                    running = 0;
-                    printf("Exiting simulation.\n");
-                    break;
-                } else 
-                {
-                    printf("Unknown command. Use 'p', '+', or '-'.\n");
-                }
-            }
+            running = 0;
+            break;
         }
 
         if (!paused) 
@@ -317,22 +624,40 @@ void simulith_server_run(void)
 
             broadcast_time();
             reset_responses();
+            uint64_t published_ns = monotonic_ns();
 
-            while (!all_clients_responded() && running) 
+            while (!all_clients_responded() && running && !simulith_server_stop_requested) 
             {
-                char buffer[64] = {0};
-                int  size       = zmq_recv(responder, buffer, sizeof(buffer) - 1, ZMQ_DONTWAIT);
+                RequestEnvelope env;
+                char buffer[SIMULITH_ACK_MAX] = {0};
+                int  size       = recv_request(ZMQ_DONTWAIT, &env, buffer, sizeof(buffer));
+                if (size > 0 && strncmp(buffer, "READY ", 6) == 0)
+                {
+                    // A handshake retry that arrived after registration closed; the
+                    // client already has its ACK, so a second reply would sit unread
+                    continue;
+                }
                 if (size > 0) 
                 {
-                    buffer[size] = '\0';
-                    handle_ack(buffer);
-                    zmq_send(responder, "ACK", 3, 0);
+                    // Async clients take the next tick as confirmation; REQ clients need a reply
+                    int slot = handle_ack(buffer);
+                    if (slot < 0 || !client_states[slot].async_ack)
+                    {
+                        send_reply(&env, "ACK");
+                    }
                 }
                 else if (errno == EAGAIN)
                 {
+                    // Clients ignore ticks they have already seen, so repeating the first one is safe
+                    if (first_tick && monotonic_ns() - published_ns >= FIRST_TICK_RETRANSMIT_NS)
+                    {
+                        publish_tick();
+                        published_ns = monotonic_ns();
+                    }
+
                     // No message available, yield CPU more aggressively for high speed
-                    if (speed >= 256.0) {
-                        // At extreme speeds, pure busy wait with minimal overhead
+                    if (preroll_active || speed >= 256.0) {
+                        // Pre-roll and extreme speeds: pure busy wait with minimal overhead
                         continue;
                     } else if (speed >= 128.0) {
                         // At very high speeds, don't yield at all - busy wait
@@ -351,52 +676,23 @@ void simulith_server_run(void)
                 
                 // Check for CLI input during wait (much less frequently at high speeds)
                 static int cli_check_counter = 0;
-                int cli_check_interval = (speed >= 256.0) ? 50000 : (speed >= 128.0) ? 20000 : (speed >= 64.0) ? 10000 : (speed >= 16.0) ? 1000 : 100;
-                if (++cli_check_counter % cli_check_interval == 0)
+                int cli_check_interval = (preroll_active || speed >= 256.0) ? 50000 : (speed >= 128.0) ? 20000 : (speed >= 64.0) ? 10000 : (speed >= 16.0) ? 1000 : 100;
+                if (++cli_check_counter % cli_check_interval == 0 && poll_cli(&paused, &speed) != 0)
                 {
-                    FD_ZERO(&readfds);
-                    FD_SET(0, &readfds);
-                    tv.tv_sec = 0;
-                    tv.tv_usec = 0;
-                    cli_ready = select(1, &readfds, NULL, NULL, &tv);
-                    if (cli_ready > 0 && FD_ISSET(0, &readfds)) 
-                    {
-                        if (fgets(cli_buf, sizeof(cli_buf), stdin)) 
-                        {
-                            if (strncmp(cli_buf, "p", 1) == 0) 
-                            {
-                                paused = !paused;
-                                printf(paused ? "Simulation paused.\n" : "Simulation resumed.\n");
-                            } else if (strncmp(cli_buf, "+", 1) == 0) 
-                            {
-                                speed *= 2.0;
-                                if (speed > 1024.0) speed = 1024.0;
-                                g_attempted_speed = speed;
-                                printf("Attempted simulation speed: %.2fx\n", speed);
-                            } else if (strncmp(cli_buf, "-", 1) == 0) 
-                            {
-                                speed /= 2.0;
-                                if (speed < 0.015625) speed = 0.015625;
-                                g_attempted_speed = speed;
-                                printf("Attempted simulation speed: %.4fx\n", speed);
-                            } else 
-                            {
-                                printf("Unknown command. Use 'p', '+', or '-'.\n");
-                            }
-                        }
-                    }
+                    running = 0;
                 }
             }
 
-            // Sleep to simulate real time (adjusted by speed), accounting for processing time
-            if (speed > 0.0) 
+            // Sleep to simulate real time (adjusted by speed), accounting for processing time.
+            // Pre-roll runs unthrottled.
+            if (speed > 0.0 && !preroll_active) 
             {
                 clock_gettime(CLOCK_MONOTONIC, &end_ts);
                 /* Use signed 64-bit for intermediate differences to avoid sign-conversion warnings */
                 int64_t sec_diff = (int64_t)end_ts.tv_sec - (int64_t)start_ts.tv_sec;
                 int64_t nsec_diff = (int64_t)end_ts.tv_nsec - (int64_t)start_ts.tv_nsec;
                 uint64_t elapsed_ns = (uint64_t)(sec_diff * 1000000000LL + nsec_diff);
-                uint64_t target_ns = (uint64_t)((double)tick_interval_ns / speed);
+                uint64_t target_ns = (uint64_t)((double)step_ns / speed);
                 
                 if (elapsed_ns < target_ns) 
                 {
@@ -424,7 +720,15 @@ void simulith_server_run(void)
                     }
                 }
             }
-            current_time_ns += tick_interval_ns;
+            current_time_ns += step_ns;
+            step_ns = choose_next_interval();
+            first_tick = 0;
+
+            // Pre-roll reached its target: hand over to paced time from this tick on
+            if (preroll_active && current_time_ns >= preroll_until_ns)
+            {
+                speed = finish_preroll();
+            }
         } else 
         {
             // If paused, sleep briefly to avoid busy loop
@@ -438,14 +742,6 @@ void simulith_server_shutdown(void)
     /* Request the server loop to stop, then proceed to close sockets. */
     simulith_server_stop_requested = 1;
 
-    if (publisher)
-        zmq_close(publisher);
-    if (responder)
-        zmq_close(responder);
-    if (server_context)
-        zmq_ctx_term(server_context);
-    publisher      = NULL;
-    responder      = NULL;
-    server_context = NULL;
+    close_sockets();
     simulith_log("Simulith server shut down\n");
 }
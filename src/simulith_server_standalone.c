@@ -1,21 +1,63 @@
 #include "simulith.h"
 
+static void print_usage(const char *prog)
+{
+    printf("Usage: %s [num_clients] [options]\n", prog);
+    printf("  --preroll-until SECONDS  Run unthrottled until this sim time\n");
+    printf("  --preroll-speed SPEED    Attempted speed once pre-roll completes (default: 1.0)\n");
+    printf("  --min-interval-ms MS     Smallest tick interval clients may request (default: 10)\n");
+    printf("  --max-interval-ms MS     Largest tick interval clients may request (default: 10)\n");
+}
+
 int main(int argc, char *argv[]) 
 {
     int num_clients = 1; // default value
+    double preroll_until_s = 0.0;
+    double preroll_speed = 1.0;
+    uint64_t interval_min_ns = INTERVAL_NS;
+    uint64_t interval_max_ns = INTERVAL_NS;
     
-    // Check if number of clients argument is provided
-    if (argc > 1) {
-        num_clients = atoi(argv[1]);
-        if (num_clients <= 0) {
-            printf("Error: Number of clients must be a positive integer\n");
-            printf("Usage: %s [num_clients]\n", argv[0]);
-            return 1;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--preroll-until") == 0 && i + 1 < argc) {
+            preroll_until_s = atof(argv[++i]);
+            if (preroll_until_s < 0.0) {
+                printf("Error: Pre-roll time must not be negative\n");
+                print_usage(argv[0]);
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--preroll-speed") == 0 && i + 1 < argc) {
+            preroll_speed = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--min-interval-ms") == 0 && i + 1 < argc) {
+            interval_min_ns = (uint64_t)(atof(argv[++i]) * 1e6);
+        } else if (strcmp(argv[i], "--max-interval-ms") == 0 && i + 1 < argc) {
+            interval_max_ns = (uint64_t)(atof(argv[++i]) * 1e6);
+        } else if (strcmp(argv[i], "--help") == 0) {
+            print_usage(argv[0]);
+            return 0;
+        } else {
+            // Check if number of clients argument is provided
+            num_clients = atoi(argv[i]);
+            if (num_clients <= 0) {
+                printf("Error: Number of clients must be a positive integer\n");
+                print_usage(argv[0]);
+                return 1;
+            }
         }
     }
     
     printf("Starting Simulith Server with %d client(s)...\n", num_clients);
-    simulith_server_init(LOCAL_PUB_ADDR, LOCAL_REP_ADDR, num_clients, INTERVAL_NS);
+    if (simulith_server_init(LOCAL_PUB_ADDR, LOCAL_REP_ADDR, num_clients, INTERVAL_NS) != 0) {
+        return 1;
+    }
+    if ((interval_min_ns != INTERVAL_NS || interval_max_ns != INTERVAL_NS) &&
+        simulith_server_set_interval_limits(interval_min_ns, interval_max_ns) != 0) {
+        simulith_server_shutdown();
+        return 1;
+    }
+    if (preroll_until_s > 0.0 && simulith_server_set_preroll((uint64_t)(preroll_until_s * 1e9), preroll_speed) != 0) {
+        simulith_server_shutdown();
+        return 1;
+    }
     simulith_server_run();
     simulith_server_shutdown();
     return 0;
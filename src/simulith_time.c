@@ -1,52 +1,156 @@
 #include "simulith_time.h"
 #include "simulith.h"
+#include <pthread.h>
+#include <stdatomic.h>
 #include <stdlib.h>
-#include <time.h>
-#include <zmq.h>
+#include <string.h>
+
+#define TIMER_RESOLUTION_NS 1000000ULL // 1 ms
+#define SOURCE_POLL_MS      100           // Longest a leader blocks before re-checking its waiter
+
+/* A thread blocked in sleep_until or wait_for_next_tick. */
+typedef struct waiter
+{
+    pthread_cond_t   cv;
+    int              done;
+    int              error;
+    simulith_timer_t timer;     // Deadline for sleep_until
+    uint64_t         wake_tick; // Tick count to wake at instead of a deadline, 0 for none
+    struct waiter*   next;
+    struct waiter**  pprev;     // NULL once off the source's lists
+} waiter_t;
+
+/* One tick subscription per publisher address, shared by every provider in
+ * the process so N tasks cost one SUB socket instead of N. */
+typedef struct tick_source {
+    char*              addr;
+    int                refcount;         // Providers using this source, under sources_lock
+    simulith_client_t* observer;         // Passive client receiving tick messages
+    _Atomic uint64_t   time_ns;          // Sim time of the latest tick received
+    uint64_t           tick_count;       // Ticks received so far, under lock
+
+    /* Waiting threads take turns receiving ticks: one leader reads the socket
+     * and advances the timer wheel while the others sleep on their own condition
+     * variable until their tick or timer comes up or they are asked to lead.
+     * Tick waiters are kept sorted by wake_tick so a tick only visits the ones
+     * it wakes; sleepers are woken by the wheel and listed only for hand-off. */
+    pthread_mutex_t          lock;
+    int                      leader_active;
+    waiter_t*                tick_waiters;
+    waiter_t*                timer_waiters;
+    simulith_timer_wheel_t*  wheel;
+
+    /* Receives ticks for the wheel while no other thread waits, so timers
+     * started with simulith_time_timer_start() fire on their own. Started
+     * with the first such timer, under driver_lock rather than lock: timer
+     * callbacks run with lock held and may start timers themselves. */
+    pthread_mutex_t          driver_lock;
+    pthread_t                driver;
+    _Atomic int              driver_running;
+    waiter_t                 driver_waiter;
+    struct tick_source*      next;
+} tick_source_t;
+
+static pthread_mutex_t sources_lock = PTHREAD_MUTEX_INITIALIZER;
+static tick_source_t*  sources      = NULL;
 
 // Time provider structure
 typedef struct {
-    void* context;       // ZMQ context
-    void* sub_socket;    // ZMQ SUB socket for tick messages
-    uint64_t tick_count; // Number of ticks received
-    double tick_interval;// Time between ticks in seconds
+    tick_source_t* source;
+    uint64_t       divisor; // Wake on every divisor-th tick
 } simulith_time_provider_t;
 
-void* simulith_time_init(void) 
+static void source_destroy(tick_source_t* source)
 {
-    simulith_time_provider_t* provider = malloc(sizeof(simulith_time_provider_t));
-    if (!provider) return NULL;
-    
-    // Initialize ZMQ context and socket
-    provider->context = zmq_ctx_new();
-    if (!provider->context) 
+    if (source->driver_running)
     {
-        free(provider);
-        return NULL;
+        pthread_mutex_lock(&source->lock);
+        source->driver_waiter.done = 1;
+        if (source->driver_waiter.pprev)
+            pthread_cond_signal(&source->driver_waiter.cv);
+        pthread_mutex_unlock(&source->lock);
+        pthread_join(source->driver, NULL);
     }
-    
-    provider->sub_socket = zmq_socket(provider->context, ZMQ_SUB);
-    if (!provider->sub_socket) 
+    simulith_client_destroy(source->observer);
+    simulith_timer_wheel_destroy(source->wheel);
+    pthread_mutex_destroy(&source->lock);
+    pthread_mutex_destroy(&source->driver_lock);
+    free(source->addr);
+    free(source);
+}
+
+static tick_source_t* source_create(const char* pub_addr)
+{
+    tick_source_t* source = calloc(1, sizeof(tick_source_t));
+    if (!source) return NULL;
+    pthread_mutex_init(&source->lock, NULL);
+    pthread_mutex_init(&source->driver_lock, NULL);
+
+    // Observe ticks without joining the server barrier
+    source->addr = strdup(pub_addr);
+    source->observer = simulith_client_create_observer(pub_addr, "time-provider");
+    source->wheel = simulith_timer_wheel_create(TIMER_RESOLUTION_NS);
+    if (!source->addr || !source->observer || !source->wheel ||
+        simulith_client_publish_clock_r(source->observer, NULL) != 0) 
     {
-        zmq_ctx_destroy(provider->context);
-        free(provider);
+        source_destroy(source);
         return NULL;
     }
+    return source;
+}
+
+static tick_source_t* source_acquire(const char* pub_addr)
+{
+    pthread_mutex_lock(&sources_lock);
+    tick_source_t* source = sources;
+    while (source && strcmp(source->addr, pub_addr) != 0)
+        source = source->next;
+    if (!source && (source = source_create(pub_addr)) != NULL)
+    {
+        source->next = sources;
+        sources = source;
+    }
+    if (source)
+        source->refcount++;
+    pthread_mutex_unlock(&sources_lock);
+    return source;
+}
+
+static void source_release(tick_source_t* source)
+{
+    pthread_mutex_lock(&sources_lock);
+    if (--source->refcount > 0)
+    {
+        pthread_mutex_unlock(&sources_lock);
+        return;
+    }
+    tick_source_t** link = &sources;
+    while (*link != source)
+        link = &(*link)->next;
+    *link = source->next;
+    pthread_mutex_unlock(&sources_lock);
+    source_destroy(source);
+}
+
+void* simulith_time_init(void) 
+{
+    return simulith_time_init_addr(LOCAL_PUB_ADDR);
+}
+
+void* simulith_time_init_addr(const char* pub_addr) 
+{
+    if (!pub_addr) return NULL;
+
+    simulith_time_provider_t* provider = calloc(1, sizeof(simulith_time_provider_t));
+    if (!provider) return NULL;
     
-    // Connect to the Simulith PUB socket
-    if (zmq_connect(provider->sub_socket, LOCAL_PUB_ADDR) != 0) 
+    provider->source = source_acquire(pub_addr);
+    if (!provider->source) 
     {
-        zmq_close(provider->sub_socket);
-        zmq_ctx_destroy(provider->context);
         free(provider);
         return NULL;
     }
-    
-    // Subscribe to tick messages
-    zmq_setsockopt(provider->sub_socket, ZMQ_SUBSCRIBE, "", 0);
-    
-    provider->tick_count = 0;
-    provider->tick_interval = INTERVAL_NS / 1e9; // Convert ns to seconds
+    provider->divisor = 1;
     
     return provider;
 }
@@ -56,40 +160,197 @@ double simulith_time_get(void* handle)
     if (!handle) return 0.0;
     
     simulith_time_provider_t* provider = (simulith_time_provider_t*)handle;
-    /* Promote tick_count to double before multiplication to avoid integer->double conversion warnings */
-    return (double)provider->tick_count * provider->tick_interval;
+    return (double)atomic_load(&provider->source->time_ns) / 1e9;
 }
 
-int simulith_time_wait_for_next_tick(void* handle) 
+double simulith_time_get_interpolated(void* handle) 
 {
-    if (!handle) return -1;
+    if (!handle) return 0.0;
     
     simulith_time_provider_t* provider = (simulith_time_provider_t*)handle;
+    return (double)simulith_clock_interpolated_ns(simulith_client_get_clock_r(provider->source->observer)) / 1e9;
+}
+
+int simulith_time_set_divisor(void* handle, unsigned int divisor) 
+{
+    if (!handle || divisor == 0) return -1;
     
-    // Wait for next tick message
-    uint64_t tick_time;
-    int result = zmq_recv(provider->sub_socket, &tick_time, sizeof(tick_time), 0);
-    if (result < 0) return -1;
-    
-    provider->tick_count++;
+    simulith_time_provider_t* provider = (simulith_time_provider_t*)handle;
+    provider->divisor = divisor;
     return 0;
 }
 
-void simulith_time_cleanup(void* handle) 
+static void waiter_wake(void* arg, uint64_t now_ns)
 {
-    if (!handle) return;
+    (void)now_ns;
+    waiter_t* w = (waiter_t*)arg;
+    w->done = 1;
+    pthread_cond_signal(&w->cv);
+}
+
+static void waiter_unlink(waiter_t* w)
+{
+    *w->pprev = w->next;
+    if (w->next)
+        w->next->pprev = w->pprev;
+    w->pprev = NULL;
+}
+
+/* Block until the waiter is done, leading tick reception whenever no other thread is.
+ * Called and returns with source->lock held. */
+static void source_wait(tick_source_t* source, waiter_t* w)
+{
+    pthread_cond_init(&w->cv, NULL);
+
+    // Ahead of later wake ticks but behind none of its own, so the common case
+    // of every task waiting for the next tick links at the head
+    waiter_t** link = w->wake_tick ? &source->tick_waiters : &source->timer_waiters;
+    while (w->wake_tick && *link && (*link)->wake_tick < w->wake_tick)
+        link = &(*link)->next;
+    w->next = *link;
+    w->pprev = link;
+    if (*link)
+        (*link)->pprev = &w->next;
+    *link = w;
+
+    while (!w->done)
+    {
+        if (source->leader_active)
+        {
+            pthread_cond_wait(&w->cv, &source->lock);
+            continue;
+        }
+
+        source->leader_active = 1;
+        pthread_mutex_unlock(&source->lock);
+        uint64_t tick_ns = 0;
+        int rc = simulith_client_wait_for_tick_timeout_r(source->observer, &tick_ns, SOURCE_POLL_MS);
+        pthread_mutex_lock(&source->lock);
+        source->leader_active = 0;
+
+        if (rc < 0)
+        {
+            w->done = 1;
+            w->error = 1;
+            break;
+        }
+        if (rc > 0)
+            continue;
+
+        atomic_store(&source->time_ns, tick_ns);
+        source->tick_count++;
+        simulith_timer_wheel_advance(source->wheel, tick_ns);
+        while (source->tick_waiters && source->tick_waiters->wake_tick <= source->tick_count)
+        {
+            waiter_t* other = source->tick_waiters;
+            waiter_unlink(other);
+            waiter_wake(other, tick_ns);
+        }
+    }
+
+    // Leave the lists, and hand leadership to a thread that still has to wait
+    if (w->pprev)
+        waiter_unlink(w);
+    if (!source->leader_active)
+    {
+        waiter_t* next = source->tick_waiters;
+        for (waiter_t* other = source->timer_waiters; !next && other; other = other->next)
+        {
+            if (!other->done)
+                next = other;
+        }
+        if (next)
+            pthread_cond_signal(&next->cv);
+    }
+    pthread_cond_destroy(&w->cv);
+}
+
+static void* source_drive(void* arg)
+{
+    tick_source_t* source = (tick_source_t*)arg;
+
+    pthread_mutex_lock(&source->lock);
+    source_wait(source, &source->driver_waiter);
+    if (source->driver_waiter.error)
+        simulith_log("Time provider stopped receiving ticks from %s\n", source->addr);
+    pthread_mutex_unlock(&source->lock);
+    return NULL;
+}
+
+int simulith_time_wait_for_next_tick(void* handle) 
+{
+    if (!handle) return -1;
     
     simulith_time_provider_t* provider = (simulith_time_provider_t*)handle;
+    tick_source_t* source = provider->source;
+    waiter_t w = { 0 };
     
-    if (provider->sub_socket) 
+    // Wait for the next tick whose count is a multiple of the divisor
+    pthread_mutex_lock(&source->lock);
+    w.wake_tick = (source->tick_count / provider->divisor + 1) * provider->divisor;
+    source_wait(source, &w);
+    pthread_mutex_unlock(&source->lock);
+    return w.error ? -1 : 0;
+}
+
+int simulith_time_sleep_until(void* handle, uint64_t sim_time_ns) 
+{
+    if (!handle) return -1;
+    
+    tick_source_t* source = ((simulith_time_provider_t*)handle)->source;
+    waiter_t w = { 0 };
+    simulith_timer_init(&w.timer, waiter_wake, &w);
+    
+    pthread_mutex_lock(&source->lock);
+    if (atomic_load(&source->time_ns) >= sim_time_ns)
     {
-        zmq_close(provider->sub_socket);
+        pthread_mutex_unlock(&source->lock);
+        return 0;
     }
+    simulith_timer_start(source->wheel, &w.timer, sim_time_ns, 0);
+    source_wait(source, &w);
+    simulith_timer_cancel(source->wheel, &w.timer);
+    pthread_mutex_unlock(&source->lock);
+    return w.error ? -1 : 0;
+}
+
+int simulith_time_timer_start(void* handle, simulith_timer_t* timer, uint64_t deadline_ns, uint64_t period_ns) 
+{
+    if (!handle) return -1;
     
-    if (provider->context) 
+    tick_source_t* source = ((simulith_time_provider_t*)handle)->source;
+    if (!atomic_load(&source->driver_running))
     {
-        zmq_ctx_destroy(provider->context);
+        pthread_mutex_lock(&source->driver_lock);
+        if (!atomic_load(&source->driver_running))
+        {
+            if (pthread_create(&source->driver, NULL, source_drive, source) != 0)
+            {
+                pthread_mutex_unlock(&source->driver_lock);
+                simulith_log("Failed to start time provider thread for %s\n", source->addr);
+                return -1;
+            }
+            atomic_store(&source->driver_running, 1);
+        }
+        pthread_mutex_unlock(&source->driver_lock);
     }
+    return simulith_timer_start(source->wheel, timer, deadline_ns, period_ns);
+}
+
+void simulith_time_timer_cancel(void* handle, simulith_timer_t* timer) 
+{
+    if (!handle) return;
+    
+    simulith_time_provider_t* provider = (simulith_time_provider_t*)handle;
+    simulith_timer_cancel(provider->source->wheel, timer);
+}
+
+void simulith_time_cleanup(void* handle) 
+{
+    if (!handle) return;
     
+    simulith_time_provider_t* provider = (simulith_time_provider_t*)handle;
+    
+    source_release(provider->source);
     free(provider);
-} 
\ No newline at end of file
+}
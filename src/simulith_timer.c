@@ -0,0 +1,241 @@
+/*
+ * Hierarchical timer wheel. Level L slots span 64^L units. A timer is filed at
+ * the lowest level whose window covers its deadline; when the level-0 cursor
+ * crosses a 64-unit boundary the matching upper-level slot is re-filed one
+ * level down. Occupancy bitmaps let the cursor skip empty level-0 slots.
+ */
+
+#include "simulith.h"
+#include <pthread.h>
+
+#define LEVELS      4
+#define SLOT_BITS   6
+#define SLOTS       (1 << SLOT_BITS)
+#define SLOT_MASK   (SLOTS - 1)
+#define PENDING     (-2) // Detached from its slot and about to fire
+
+struct simulith_timer_wheel
+{
+    pthread_mutex_t   lock; // Recursive so callbacks can start and cancel timers
+    uint64_t          resolution_ns;
+    uint64_t          current; // Next unit to process
+    uint64_t          armed;
+    int               advancing;
+    uint64_t          occupied[LEVELS];
+    simulith_timer_t* slots[LEVELS][SLOTS];
+    simulith_timer_t* pending; // Timers expiring in the unit being processed
+};
+
+static void list_push(simulith_timer_t** head, simulith_timer_t* timer)
+{
+    timer->next  = *head;
+    timer->pprev = head;
+    if (*head)
+        (*head)->pprev = &timer->next;
+    *head = timer;
+}
+
+static void timer_unlink(simulith_timer_wheel_t* wheel, simulith_timer_t* timer)
+{
+    *timer->pprev = timer->next;
+    if (timer->next)
+        timer->next->pprev = timer->pprev;
+
+    if (timer->bucket >= 0)
+    {
+        int level = timer->bucket / SLOTS;
+        int slot  = timer->bucket % SLOTS;
+        if (!wheel->slots[level][slot])
+            wheel->occupied[level] &= ~(1ULL << slot);
+    }
+    timer->bucket = -1;
+    timer->next   = NULL;
+    timer->pprev  = NULL;
+    wheel->armed--;
+}
+
+static void timer_file(simulith_timer_wheel_t* wheel, simulith_timer_t* timer)
+{
+    uint64_t expires = timer->expires > wheel->current ? timer->expires : wheel->current;
+    uint64_t delta   = expires - wheel->current;
+
+    int level = 0;
+    while (level < LEVELS && delta >= (1ULL << (SLOT_BITS * (level + 1))))
+        level++;
+    if (level == LEVELS)
+    {
+        // Beyond the wheel: park in the furthest top-level slot and re-file later
+        level   = LEVELS - 1;
+        expires = wheel->current + (1ULL << (SLOT_BITS * LEVELS)) - 1;
+    }
+
+    int slot      = (int)((expires >> (SLOT_BITS * level)) & SLOT_MASK);
+    timer->bucket = level * SLOTS + slot;
+    list_push(&wheel->slots[level][slot], timer);
+    wheel->occupied[level] |= 1ULL << slot;
+    wheel->armed++;
+}
+
+/* At a 64-unit boundary, re-file the upper-level slots that start here, highest first. */
+static void cascade(simulith_timer_wheel_t* wheel)
+{
+    int top = 1;
+    while (top < LEVELS - 1 && (wheel->current & ((1ULL << (SLOT_BITS * (top + 1))) - 1)) == 0)
+        top++;
+
+    for (int level = top; level >= 1; --level)
+    {
+        int               slot = (int)((wheel->current >> (SLOT_BITS * level)) & SLOT_MASK);
+        simulith_timer_t* list = wheel->slots[level][slot];
+        wheel->slots[level][slot] = NULL;
+        wheel->occupied[level] &= ~(1ULL << slot);
+        while (list)
+        {
+            simulith_timer_t* timer = list;
+            list                    = timer->next;
+            wheel->armed--;
+            timer_file(wheel, timer);
+        }
+    }
+}
+
+simulith_timer_wheel_t* simulith_timer_wheel_create(uint64_t resolution_ns)
+{
+    if (resolution_ns == 0)
+    {
+        simulith_log("Invalid timer resolution: must be greater than 0\n");
+        return NULL;
+    }
+
+    simulith_timer_wheel_t* wheel = calloc(1, sizeof(*wheel));
+    if (!wheel)
+        return NULL;
+
+    pthread_mutexattr_t attr;
+    pthread_mutexattr_init(&attr);
+    pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
+    pthread_mutex_init(&wheel->lock, &attr);
+    pthread_mutexattr_destroy(&attr);
+
+    wheel->resolution_ns = resolution_ns;
+    return wheel;
+}
+
+void simulith_timer_wheel_destroy(simulith_timer_wheel_t* wheel)
+{
+    if (!wheel)
+        return;
+    pthread_mutex_destroy(&wheel->lock);
+    free(wheel);
+}
+
+void simulith_timer_init(simulith_timer_t* timer, simulith_timer_callback callback, void* arg)
+{
+    if (!timer)
+        return;
+    memset(timer, 0, sizeof(*timer));
+    timer->callback = callback;
+    timer->arg      = arg;
+    timer->bucket   = -1;
+}
+
+int simulith_timer_is_armed(const simulith_timer_t* timer)
+{
+    return timer && timer->bucket != -1;
+}
+
+int simulith_timer_start(simulith_timer_wheel_t* wheel, simulith_timer_t* timer, uint64_t deadline_ns,
+                         uint64_t period_ns)
+{
+    if (!wheel || !timer || !timer->callback)
+        return -1;
+
+    pthread_mutex_lock(&wheel->lock);
+    if (timer->bucket != -1)
+        timer_unlink(wheel, timer);
+    timer->deadline_ns = deadline_ns;
+    timer->period_ns   = period_ns;
+    // Round up so a timer never fires before its deadline
+    timer->expires = deadline_ns / wheel->resolution_ns + (deadline_ns % wheel->resolution_ns != 0);
+    timer_file(wheel, timer);
+    pthread_mutex_unlock(&wheel->lock);
+    return 0;
+}
+
+void simulith_timer_cancel(simulith_timer_wheel_t* wheel, simulith_timer_t* timer)
+{
+    if (!wheel || !timer)
+        return;
+
+    pthread_mutex_lock(&wheel->lock);
+    if (timer->bucket != -1)
+        timer_unlink(wheel, timer);
+    pthread_mutex_unlock(&wheel->lock);
+}
+
+int simulith_timer_wheel_advance(simulith_timer_wheel_t* wheel, uint64_t now_ns)
+{
+    if (!wheel)
+        return -1;
+
+    pthread_mutex_lock(&wheel->lock);
+    if (wheel->advancing)
+    {
+        pthread_mutex_unlock(&wheel->lock);
+        return -1;
+    }
+    wheel->advancing = 1;
+
+    uint64_t target = now_ns / wheel->resolution_ns;
+    int      fired  = 0;
+    while (wheel->current <= target)
+    {
+        if (wheel->armed == 0)
+        {
+            wheel->current = target + 1;
+            break;
+        }
+        if ((wheel->current & SLOT_MASK) == 0)
+            cascade(wheel);
+
+        // Move the due slot to the pending list so callbacks can cancel its timers
+        int slot = (int)(wheel->current & SLOT_MASK);
+        if (wheel->slots[0][slot])
+        {
+            wheel->pending = wheel->slots[0][slot];
+            wheel->pending->pprev = &wheel->pending;
+            wheel->slots[0][slot] = NULL;
+            wheel->occupied[0] &= ~(1ULL << slot);
+            for (simulith_timer_t* t = wheel->pending; t; t = t->next)
+                t->bucket = PENDING;
+        }
+        wheel->current++;
+
+        while (wheel->pending)
+        {
+            simulith_timer_t* timer = wheel->pending;
+            timer_unlink(wheel, timer);
+            if (timer->period_ns)
+            {
+                uint64_t next = timer->deadline_ns + timer->period_ns;
+                if (next <= now_ns)
+                    next += ((now_ns - next) / timer->period_ns + 1) * timer->period_ns;
+                simulith_timer_start(wheel, timer, next, timer->period_ns);
+            }
+            timer->callback(timer->arg, now_ns);
+            fired++;
+        }
+
+        // Skip to the next occupied level-0 slot within this 64-unit block
+        if (wheel->current <= target && (wheel->current & SLOT_MASK) != 0)
+        {
+            uint64_t mask = wheel->occupied[0] >> (wheel->current & SLOT_MASK);
+            uint64_t next = mask ? wheel->current + (uint64_t)__builtin_ctzll(mask) : (wheel->current | SLOT_MASK) + 1;
+            wheel->current = next < target + 1 ? next : target + 1;
+        }
+    }
+
+    wheel->advancing = 0;
+    pthread_mutex_unlock(&wheel->lock);
+    return fired;
+}
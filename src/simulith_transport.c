@@ -3,50 +3,1248 @@
  */
 
 #include "simulith_transport.h"
+#include <fnmatch.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <sys/eventfd.h>
+
+#define FRAME_MASK (SIMULITH_TRANSPORT_MAX_FRAMES - 1)
+#define REACTOR_QUEUE_SIZE 256 /* Messages per direction per port, a power of two */
+#define REACTOR_QUEUE_MASK (REACTOR_QUEUE_SIZE - 1)
+#define BUS_DEVICE_TAG 0x01 /* First byte of a bus device's routing identity */
+#define BUS_POLL_MS 100
+#define UART_DEFAULT_FRAME_BITS 10 /* 8N1: start bit, 8 data bits, stop bit */
+#define CAPTURE_SLOTS 4096 /* Frames the capture ring holds, a power of two */
+#define CAPTURE_MASK (CAPTURE_SLOTS - 1)
+#define CAPTURE_IDLE_US 1000
+#define PCAPNG_LINKTYPE_USER0 147
+
+_Static_assert((SIMULITH_TRANSPORT_MAX_FRAMES & FRAME_MASK) == 0, "SIMULITH_TRANSPORT_MAX_FRAMES must be a power of two");
+_Static_assert((REACTOR_QUEUE_SIZE & REACTOR_QUEUE_MASK) == 0, "REACTOR_QUEUE_SIZE must be a power of two");
+_Static_assert((CAPTURE_SLOTS & CAPTURE_MASK) == 0, "CAPTURE_SLOTS must be a power of two");
+
+/* Sim time for link models and captures, set from the tick stream */
+static _Atomic uint64_t transport_time_ns = 0;
+
+/* Single-producer single-consumer message queue between the reactor thread
+ * and the thread that owns a port */
+typedef struct {
+    _Atomic size_t head; /* Written by the consumer */
+    _Atomic size_t tail; /* Written by the producer */
+    zmq_msg_t slots[REACTOR_QUEUE_SIZE];
+} msg_queue_t;
+
+/* A port serviced by the reactor. While attached, only the reactor thread
+ * touches the port's socket. */
+struct transport_reactor_link {
+    transport_port_t *port;
+    msg_queue_t rx; /* Reactor to application */
+    msg_queue_t tx; /* Application to reactor */
+    struct transport_reactor_link *next;
+};
+
+static pthread_mutex_t reactor_lock    = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t  reactor_cond    = PTHREAD_COND_INITIALIZER;
+static pthread_t       reactor_thread;
+static int             reactor_running = 0;
+static int             reactor_wake_fd = -1;
+static atomic_int      reactor_stop    = 0;
+static _Atomic uint64_t reactor_gen    = 0; /* Bumped on every attach and detach */
+static uint64_t        reactor_acked   = 0; /* Generation the reactor thread has applied, under reactor_lock */
+static struct transport_reactor_link *reactor_links = NULL; /* Under reactor_lock */
+
+/* Server ports bound in this process. A client connecting to one of these
+ * addresses uses an inproc alias on the shared context instead, skipping the
+ * kernel. Disable with SIMULITH_TRANSPORT_INPROC=0. */
+typedef struct bound_port {
+    const void *owner; /* Server port or bus broker */
+    char address[128];
+    struct bound_port *next;
+} bound_port_t;
+
+static pthread_mutex_t bound_lock  = PTHREAD_MUTEX_INITIALIZER;
+static bound_port_t   *bound_ports = NULL;
+
+/* Counters of one initialised port, listed for simulith_transport_foreach_stats() */
+struct transport_port_stats {
+    char name[64];
+    _Atomic uint64_t tx_msgs;
+    _Atomic uint64_t tx_bytes;
+    _Atomic uint64_t tx_errors;
+    _Atomic uint64_t rx_msgs;
+    _Atomic uint64_t rx_bytes;
+    _Atomic uint64_t rx_dropped;
+    _Atomic uint64_t rx_overflows;
+    _Atomic uint64_t rx_gaps;
+    _Atomic uint64_t uart_overruns;
+    pthread_mutex_t latency_lock;
+    simulith_histogram_t latency;
+    struct transport_port_stats *next;
+};
+
+static pthread_mutex_t stats_lock  = PTHREAD_MUTEX_INITIALIZER;
+static struct transport_port_stats *stats_ports = NULL;
+
+/* Largest RX ring a port may ask for */
+#define RX_BUF_LIMIT ((size_t)1 << 30)
+
+/* Everything init sets up for a port beyond its socket */
+struct transport_port_state {
+    int mode;
+    uint16_t bus_addr;
+    /* RX ring for incoming data. Head and tail run freely and are masked on
+     * access, so tail - head is the number of buffered bytes. */
+    size_t rx_buf_size;
+    uint8_t *rx_buf;
+    size_t rx_head;
+    size_t rx_tail;
+    size_t rx_limit; /* End of the bytes the application may read */
+    /* Bytes left of each buffered message, so receive stops at message ends */
+    uint32_t rx_frames[SIMULITH_TRANSPORT_MAX_FRAMES];
+    size_t rx_frame_head;
+    size_t rx_frame_tail;
+    size_t rx_buf_max; /* Size the ring may grow to, 0 = fixed */
+    int rx_stream;
+    zmq_msg_t rx_large; /* Message too big for the ring, lent in place */
+    int rx_large_valid;
+    size_t rx_large_off; /* Bytes of rx_large already consumed */
+    /* Message received while the ring was full, ingested once there is room */
+    zmq_msg_t rx_pending;
+    int rx_pending_valid;
+    struct transport_reactor_link *reactor; /* Set while the reactor services this port */
+    uint32_t uart_baud;
+    uint8_t uart_frame_bits;
+    size_t uart_fifo_depth;
+    uint64_t uart_line_free_ns; /* Sim time the last byte received finishes arriving */
+    int stamped;
+    uint64_t delivery_delay_ns;
+    uint32_t tx_seq;
+    uint32_t rx_seq_next;
+    int rx_seq_valid;
+    uint64_t rx_due[SIMULITH_TRANSPORT_MAX_FRAMES]; /* Release time of each buffered message */
+    size_t rx_frame_limit; /* End of the messages the application may read */
+    uint32_t latency_sample;
+    struct transport_port_stats *stats; /* Counters, see simulith_transport_get_stats() */
+    uint32_t capture_id; /* Nonzero while a capture records this port */
+};
+
+/* Packet capture. Any thread appends frames to a bounded multi-producer ring
+ * (each slot carries a sequence number saying whose turn it is) without
+ * locking or blocking; a writer thread turns them into pcapng. When the ring
+ * is full, frames are counted and dropped rather than slowing the sim down. */
+enum { CAPTURE_PORT, CAPTURE_RX, CAPTURE_TX };
+
+typedef struct {
+    _Atomic size_t seq;
+    uint32_t port_id;
+    uint8_t kind;
+    uint32_t orig_len;
+    uint32_t cap_len;
+    uint64_t time_ns;
+    uint8_t data[SIMULITH_TRANSPORT_CAPTURE_SNAPLEN];
+} capture_slot_t;
+
+static pthread_mutex_t capture_lock    = PTHREAD_MUTEX_INITIALIZER;
+static pthread_once_t  capture_env     = PTHREAD_ONCE_INIT;
+static pthread_t       capture_thread;
+static capture_slot_t *capture_slots   = NULL;
+static FILE           *capture_file    = NULL;
+static char            capture_filter[256];
+static atomic_int      capture_active  = 0;
+static atomic_int      capture_users   = 0; /* Producers inside capture_push */
+static atomic_int      capture_stop    = 0;
+static _Atomic size_t  capture_tail    = 0;
+static size_t          capture_head    = 0; /* Writer thread only */
+static _Atomic uint32_t capture_next_id = 0;
+static _Atomic uint64_t capture_dropped = 0;
+static uint64_t        capture_written = 0;
+
+static int capture_push(uint32_t port_id, int kind, const void *data, size_t len)
+{
+    if (!atomic_load_explicit(&capture_active, memory_order_acquire)) return 0;
+    atomic_fetch_add(&capture_users, 1);
+    if (!atomic_load(&capture_active)) {
+        atomic_fetch_sub(&capture_users, 1);
+        return 0;
+    }
+
+    size_t pos = atomic_load_explicit(&capture_tail, memory_order_relaxed);
+    capture_slot_t *slot;
+    for (;;) {
+        slot = &capture_slots[pos & CAPTURE_MASK];
+        intptr_t diff = (intptr_t)atomic_load_explicit(&slot->seq, memory_order_acquire) - (intptr_t)pos;
+        if (diff == 0) {
+            if (atomic_compare_exchange_weak_explicit(&capture_tail, &pos, pos + 1,
+                                                      memory_order_relaxed, memory_order_relaxed)) break;
+        } else if (diff < 0) {
+            atomic_fetch_add_explicit(&capture_dropped, 1, memory_order_relaxed);
+            atomic_fetch_sub(&capture_users, 1);
+            return 0;
+        } else {
+            pos = atomic_load_explicit(&capture_tail, memory_order_relaxed);
+        }
+    }
+    slot->port_id = port_id;
+    slot->kind = (uint8_t)kind;
+    slot->orig_len = (uint32_t)len;
+    slot->cap_len = (uint32_t)(len < SIMULITH_TRANSPORT_CAPTURE_SNAPLEN ? len : SIMULITH_TRANSPORT_CAPTURE_SNAPLEN);
+    slot->time_ns = atomic_load_explicit(&transport_time_ns, memory_order_relaxed);
+    memcpy(slot->data, data, slot->cap_len);
+    atomic_store_explicit(&slot->seq, pos + 1, memory_order_release);
+    atomic_fetch_sub(&capture_users, 1);
+    return 1;
+}
+
+/* Write one pcapng block: header, body padded to 32 bits, options, trailer */
+static void pcapng_block(uint32_t type, const void *body, size_t body_len, const void *opts, size_t opts_len)
+{
+    static const uint8_t pad[4] = {0};
+    size_t body_pad = (4 - (body_len & 3)) & 3;
+    uint32_t total = (uint32_t)(12 + body_len + body_pad + opts_len);
+    fwrite(&type, 4, 1, capture_file);
+    fwrite(&total, 4, 1, capture_file);
+    fwrite(body, 1, body_len, capture_file);
+    fwrite(pad, 1, body_pad, capture_file);
+    fwrite(opts, 1, opts_len, capture_file);
+    fwrite(&total, 4, 1, capture_file);
+}
+
+/* Append a pcapng option to buf at *len; values are padded to 32 bits */
+static void pcapng_opt(uint8_t *buf, size_t *len, uint16_t code, const void *value, uint16_t value_len)
+{
+    memcpy(buf + *len, &code, 2);
+    memcpy(buf + *len + 2, &value_len, 2);
+    memcpy(buf + *len + 4, value, value_len);
+    size_t padded = ((size_t)value_len + 3) & ~(size_t)3;
+    memset(buf + *len + 4 + value_len, 0, padded - value_len);
+    *len += 4 + padded;
+}
+
+static void capture_write(const capture_slot_t *slot, uint32_t *iface_of, uint32_t iface_max, uint32_t *iface_count)
+{
+    uint8_t opts[128];
+    size_t opts_len = 0;
+    static const uint8_t end[4] = {0};
+
+    if (slot->kind == CAPTURE_PORT) {
+        /* One interface per port, named after it, with nanosecond sim time stamps */
+        struct { uint16_t linktype; uint16_t reserved; uint32_t snaplen; } idb = {
+            PCAPNG_LINKTYPE_USER0, 0, SIMULITH_TRANSPORT_CAPTURE_SNAPLEN
+        };
+        uint8_t tsresol = 9;
+        pcapng_opt(opts, &opts_len, 2, slot->data, (uint16_t)(slot->cap_len < 64 ? slot->cap_len : 64));
+        pcapng_opt(opts, &opts_len, 9, &tsresol, 1);
+        memcpy(opts + opts_len, end, 4);
+        opts_len += 4;
+        pcapng_block(1, &idb, sizeof(idb), opts, opts_len);
+        if (slot->port_id < iface_max) iface_of[slot->port_id] = (*iface_count)++;
+        return;
+    }
+    /* Ports attached to an earlier capture have no interface in this file */
+    if (slot->port_id >= iface_max || iface_of[slot->port_id] == UINT32_MAX) return;
+
+    struct { uint32_t iface; uint32_t ts_high; uint32_t ts_low; uint32_t cap_len; uint32_t orig_len; } epb = {
+        iface_of[slot->port_id], (uint32_t)(slot->time_ns >> 32), (uint32_t)slot->time_ns, slot->cap_len, slot->orig_len
+    };
+    uint8_t body[sizeof(epb) + SIMULITH_TRANSPORT_CAPTURE_SNAPLEN];
+    memcpy(body, &epb, sizeof(epb));
+    memcpy(body + sizeof(epb), slot->data, slot->cap_len);
+    uint32_t flags = slot->kind == CAPTURE_RX ? 1 : 2; /* Inbound, outbound */
+    pcapng_opt(opts, &opts_len, 2, &flags, 4);
+    memcpy(opts + opts_len, end, 4);
+    opts_len += 4;
+    pcapng_block(6, body, sizeof(epb) + slot->cap_len, opts, opts_len);
+    capture_written++;
+}
+
+static void *capture_main(void *arg)
+{
+    (void)arg;
+    uint32_t iface_max = 1024;
+    uint32_t *iface_of = malloc(iface_max * sizeof(*iface_of));
+    uint32_t iface_count = 0;
+    if (iface_of) memset(iface_of, 0xff, iface_max * sizeof(*iface_of));
+
+    for (;;) {
+        capture_slot_t *slot = &capture_slots[capture_head & CAPTURE_MASK];
+        if (atomic_load_explicit(&slot->seq, memory_order_acquire) != capture_head + 1) {
+            /* Empty: finish once stopped and no producer is mid-push */
+            if (atomic_load(&capture_stop) && atomic_load(&capture_users) == 0 &&
+                atomic_load_explicit(&slot->seq, memory_order_acquire) != capture_head + 1) break;
+            fflush(capture_file);
+            usleep(CAPTURE_IDLE_US);
+            continue;
+        }
+        if (slot->port_id >= iface_max && iface_of) {
+            uint32_t *grown = realloc(iface_of, (size_t)slot->port_id * 2 * sizeof(*iface_of));
+            if (grown) {
+                memset(grown + iface_max, 0xff, ((size_t)slot->port_id * 2 - iface_max) * sizeof(*grown));
+                iface_of = grown;
+                iface_max = slot->port_id * 2;
+            }
+        }
+        if (iface_of) capture_write(slot, iface_of, iface_max, &iface_count);
+        atomic_store_explicit(&slot->seq, capture_head + CAPTURE_SLOTS, memory_order_release);
+        capture_head++;
+    }
+    free(iface_of);
+    return NULL;
+}
+
+static void capture_env_start(void)
+{
+    const char *path = getenv("SIMULITH_CAPTURE");
+    if (path && path[0] && simulith_transport_capture_start(path, getenv("SIMULITH_CAPTURE_FILTER")) == 0) {
+        atexit(simulith_transport_capture_stop);
+    }
+}
+
+/* Whether a port name matches the comma-separated glob patterns of the filter */
+static int capture_match(const char *name)
+{
+    if (!capture_filter[0]) return 1;
+    char patterns[sizeof(capture_filter)];
+    strcpy(patterns, capture_filter);
+    char *save = NULL;
+    for (char *p = strtok_r(patterns, ",", &save); p; p = strtok_r(NULL, ",", &save)) {
+        if (fnmatch(p, name, 0) == 0) return 1;
+    }
+    return 0;
+}
+
+/* Give a newly initialised port a capture id if it passes the filter */
+static void capture_attach(transport_port_t *port)
+{
+    pthread_once(&capture_env, capture_env_start);
+    port->state->capture_id = 0;
+    pthread_mutex_lock(&capture_lock);
+    if (atomic_load(&capture_active) && capture_match(port->name)) {
+        uint32_t id = atomic_fetch_add(&capture_next_id, 1) + 1;
+        /* Without its interface block the port's frames could not be written */
+        if (capture_push(id, CAPTURE_PORT, port->name, strlen(port->name))) port->state->capture_id = id;
+    }
+    pthread_mutex_unlock(&capture_lock);
+}
+
+int simulith_transport_capture_start(const char *path, const char *filter)
+{
+    if (!path) return SIMULITH_TRANSPORT_ERROR;
+    pthread_mutex_lock(&capture_lock);
+    if (capture_slots) {
+        pthread_mutex_unlock(&capture_lock);
+        simulith_log("simulith_transport_capture_start: Capture already running\n");
+        return SIMULITH_TRANSPORT_ERROR;
+    }
+    capture_file = fopen(path, "wb");
+    capture_slots = calloc(CAPTURE_SLOTS, sizeof(*capture_slots));
+    if (!capture_file || !capture_slots) {
+        simulith_log("simulith_transport_capture_start: Failed to open %s\n", path);
+        if (capture_file) fclose(capture_file);
+        free(capture_slots);
+        capture_file = NULL;
+        capture_slots = NULL;
+        pthread_mutex_unlock(&capture_lock);
+        return SIMULITH_TRANSPORT_ERROR;
+    }
+    for (size_t i = 0; i < CAPTURE_SLOTS; ++i) atomic_init(&capture_slots[i].seq, i);
+    capture_head = 0;
+    atomic_store(&capture_tail, 0);
+    atomic_store(&capture_dropped, 0);
+    capture_written = 0;
+    snprintf(capture_filter, sizeof(capture_filter), "%s", filter ? filter : "");
+
+    /* Section header: byte-order magic, version 1.0, unknown section length */
+    struct { uint32_t magic; uint16_t major; uint16_t minor; int64_t length; } shb = { 0x1A2B3C4D, 1, 0, -1 };
+    pcapng_block(0x0A0D0D0A, &shb, sizeof(shb), NULL, 0);
+
+    atomic_store(&capture_stop, 0);
+    if (pthread_create(&capture_thread, NULL, capture_main, NULL) != 0) {
+        simulith_log("simulith_transport_capture_start: Failed to start thread\n");
+        fclose(capture_file);
+        free(capture_slots);
+        capture_file = NULL;
+        capture_slots = NULL;
+        pthread_mutex_unlock(&capture_lock);
+        return SIMULITH_TRANSPORT_ERROR;
+    }
+    atomic_store_explicit(&capture_active, 1, memory_order_release);
+    pthread_mutex_unlock(&capture_lock);
+    simulith_log("simulith_transport_capture_start: Capturing %s to %s\n", capture_filter[0] ? capture_filter : "all ports", path);
+    return SIMULITH_TRANSPORT_SUCCESS;
+}
+
+void simulith_transport_capture_stop(void)
+{
+    pthread_mutex_lock(&capture_lock);
+    if (!capture_slots) {
+        pthread_mutex_unlock(&capture_lock);
+        return;
+    }
+    atomic_store(&capture_active, 0);
+    atomic_store(&capture_stop, 1);
+    pthread_join(capture_thread, NULL);
+    fclose(capture_file);
+    free(capture_slots);
+    capture_file = NULL;
+    capture_slots = NULL;
+    simulith_log("Capture stopped: %llu frames written, %llu dropped\n", (unsigned long long)capture_written,
+                 (unsigned long long)atomic_load(&capture_dropped));
+    pthread_mutex_unlock(&capture_lock);
+}
+
+static void stat_add(_Atomic uint64_t *counter, uint64_t n)
+{
+    atomic_fetch_add_explicit(counter, n, memory_order_relaxed);
+}
+
+static uint64_t monotonic_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+static struct transport_port_stats *stats_create(const char *name)
+{
+    struct transport_port_stats *stats = calloc(1, sizeof(*stats));
+    if (!stats) return NULL;
+    strncpy(stats->name, name, sizeof(stats->name) - 1);
+    pthread_mutex_init(&stats->latency_lock, NULL);
+    pthread_mutex_lock(&stats_lock);
+    stats->next = stats_ports;
+    stats_ports = stats;
+    pthread_mutex_unlock(&stats_lock);
+    return stats;
+}
+
+static void stats_destroy(struct transport_port_stats *stats)
+{
+    if (!stats) return;
+    pthread_mutex_lock(&stats_lock);
+    for (struct transport_port_stats **pp = &stats_ports; *pp; pp = &(*pp)->next) {
+        if (*pp == stats) {
+            *pp = stats->next;
+            break;
+        }
+    }
+    pthread_mutex_unlock(&stats_lock);
+    pthread_mutex_destroy(&stats->latency_lock);
+    free(stats);
+}
+
+static void stats_read(struct transport_port_stats *stats, simulith_transport_stats_t *out)
+{
+    memset(out, 0, sizeof(*out));
+    out->tx_msgs = atomic_load_explicit(&stats->tx_msgs, memory_order_relaxed);
+    out->tx_bytes = atomic_load_explicit(&stats->tx_bytes, memory_order_relaxed);
+    out->tx_errors = atomic_load_explicit(&stats->tx_errors, memory_order_relaxed);
+    out->rx_msgs = atomic_load_explicit(&stats->rx_msgs, memory_order_relaxed);
+    out->rx_bytes = atomic_load_explicit(&stats->rx_bytes, memory_order_relaxed);
+    out->rx_dropped = atomic_load_explicit(&stats->rx_dropped, memory_order_relaxed);
+    out->rx_overflows = atomic_load_explicit(&stats->rx_overflows, memory_order_relaxed);
+    out->rx_gaps = atomic_load_explicit(&stats->rx_gaps, memory_order_relaxed);
+    out->uart_overruns = atomic_load_explicit(&stats->uart_overruns, memory_order_relaxed);
+    pthread_mutex_lock(&stats->latency_lock);
+    if (stats->latency.count) {
+        out->latency_samples = stats->latency.count;
+        out->latency_mean_ns = stats->latency.total_ns / stats->latency.count;
+        out->latency_p99_ns = simulith_histogram_percentile(&stats->latency, 99.0);
+        out->latency_max_ns = stats->latency.max_ns;
+    }
+    pthread_mutex_unlock(&stats->latency_lock);
+}
+
+static int inproc_enabled(void)
+{
+    const char *env = getenv("SIMULITH_TRANSPORT_INPROC");
+    return !(env && strcmp(env, "0") == 0);
+}
+
+static void inproc_alias(const char *address, char *alias, size_t size)
+{
+    snprintf(alias, size, "inproc://simulith:%s", address);
+}
+
+static void bound_add(const void *owner, const char *address)
+{
+    bound_port_t *entry = calloc(1, sizeof(*entry));
+    if (!entry) return;
+    entry->owner = owner;
+    strncpy(entry->address, address, sizeof(entry->address) - 1);
+    pthread_mutex_lock(&bound_lock);
+    entry->next = bound_ports;
+    bound_ports = entry;
+    pthread_mutex_unlock(&bound_lock);
+}
+
+static void bound_remove(const void *owner)
+{
+    pthread_mutex_lock(&bound_lock);
+    for (bound_port_t **pp = &bound_ports; *pp; pp = &(*pp)->next) {
+        if ((*pp)->owner == owner) {
+            bound_port_t *entry = *pp;
+            *pp = entry->next;
+            free(entry);
+            break;
+        }
+    }
+    pthread_mutex_unlock(&bound_lock);
+}
+
+static int bound_here(const char *address)
+{
+    pthread_mutex_lock(&bound_lock);
+    bound_port_t *entry = bound_ports;
+    while (entry && strcmp(entry->address, address) != 0) entry = entry->next;
+    pthread_mutex_unlock(&bound_lock);
+    return entry != NULL;
+}
+
+/* Bind address and, unless disabled, its inproc alias, registering owner */
+static int bind_with_alias(void *sock, const void *owner, const char *address)
+{
+    if (zmq_bind(sock, address) != 0) {
+        return -1;
+    }
+    char alias[160];
+    inproc_alias(address, alias, sizeof(alias));
+    if (inproc_enabled() && strncmp(address, "inproc://", 9) != 0 && zmq_bind(sock, alias) == 0) {
+        bound_add(owner, address);
+    }
+    return 0;
+}
+
+static int queue_push(msg_queue_t *q, zmq_msg_t *msg)
+{
+    size_t tail = atomic_load_explicit(&q->tail, memory_order_relaxed);
+    if (tail - atomic_load_explicit(&q->head, memory_order_acquire) == REACTOR_QUEUE_SIZE) return 0;
+    zmq_msg_t *slot = &q->slots[tail & REACTOR_QUEUE_MASK];
+    zmq_msg_init(slot);
+    zmq_msg_move(slot, msg);
+    atomic_store_explicit(&q->tail, tail + 1, memory_order_release);
+    return 1;
+}
+
+static int queue_pop(msg_queue_t *q, zmq_msg_t *msg)
+{
+    size_t head = atomic_load_explicit(&q->head, memory_order_relaxed);
+    if (head == atomic_load_explicit(&q->tail, memory_order_acquire)) return 0;
+    zmq_msg_t *slot = &q->slots[head & REACTOR_QUEUE_MASK];
+    zmq_msg_move(msg, slot);
+    zmq_msg_close(slot);
+    atomic_store_explicit(&q->head, head + 1, memory_order_release);
+    return 1;
+}
+
+static int queue_full(msg_queue_t *q)
+{
+    return atomic_load_explicit(&q->tail, memory_order_relaxed) -
+           atomic_load_explicit(&q->head, memory_order_acquire) == REACTOR_QUEUE_SIZE;
+}
+
+static void reactor_wake(void)
+{
+    uint64_t one = 1;
+    if (write(reactor_wake_fd, &one, sizeof(one)) < 0) {
+        simulith_log("transport reactor: wake failed\n");
+    }
+}
+
+/* Send a message on the port's socket; closes it either way */
+static int socket_send(transport_port_t *port, zmq_msg_t *msg)
+{
+    size_t len = zmq_msg_size(msg);
+    if (zmq_msg_send(msg, port->zmq_sock, ZMQ_DONTWAIT) < 0) {
+        zmq_msg_close(msg);
+        stat_add(&port->state->stats->tx_errors, 1);
+        simulith_log("simulith_transport_send: zmq_send failed (peer may be unavailable)\n");
+        return SIMULITH_TRANSPORT_ERROR;
+    }
+    stat_add(&port->state->stats->tx_msgs, 1);
+    stat_add(&port->state->stats->tx_bytes, len);
+    return (int)len;
+}
+
+/* Send a message, through the reactor if the port is attached; takes ownership */
+static int tx_msg(transport_port_t *port, zmq_msg_t *msg)
+{
+    if (port->state->capture_id) capture_push(port->state->capture_id, CAPTURE_TX, zmq_msg_data(msg), zmq_msg_size(msg));
+    if (!port->state->reactor) {
+        return socket_send(port, msg);
+    }
+    int len = (int)zmq_msg_size(msg);
+    if (!queue_push(&port->state->reactor->tx, msg)) {
+        zmq_msg_close(msg);
+        stat_add(&port->state->stats->tx_errors, 1);
+        simulith_log("simulith_transport_send: TX queue full on %s\n", port->name);
+        return SIMULITH_TRANSPORT_ERROR;
+    }
+    reactor_wake();
+    return len;
+}
+
+/* Take the next received message: from the reactor's queue when attached,
+ * else straight from the socket. Returns its size, -1 if there is none. */
+static int rx_next(transport_port_t *port, zmq_msg_t *msg)
+{
+    int size;
+    if (port->state->reactor) {
+        size = queue_pop(&port->state->reactor->rx, msg) ? (int)zmq_msg_size(msg) : -1;
+    } else {
+        size = zmq_msg_recv(msg, port->zmq_sock, ZMQ_DONTWAIT);
+    }
+    if (size >= 0 && port->state->capture_id) capture_push(port->state->capture_id, CAPTURE_RX, zmq_msg_data(msg), (size_t)size);
+    return size;
+}
+
+static void *reactor_main(void *arg)
+{
+    (void)arg;
+    zmq_pollitem_t *items = NULL;
+    struct transport_reactor_link **polled = NULL;
+    size_t count = 0;
+    uint64_t seen = (uint64_t)-1;
+
+    while (!atomic_load(&reactor_stop)) {
+        /* Pick up attached and detached ports, then release their owners */
+        uint64_t gen = atomic_load(&reactor_gen);
+        if (gen != seen) {
+            pthread_mutex_lock(&reactor_lock);
+            count = 0;
+            for (struct transport_reactor_link *l = reactor_links; l; l = l->next) count++;
+            items = realloc(items, (count + 1) * sizeof(*items));
+            polled = realloc(polled, (count + 1) * sizeof(*polled));
+            size_t i = 0;
+            for (struct transport_reactor_link *l = reactor_links; l; l = l->next) polled[i++] = l;
+            seen = atomic_load(&reactor_gen);
+            reactor_acked = seen;
+            pthread_cond_broadcast(&reactor_cond);
+            pthread_mutex_unlock(&reactor_lock);
+        }
+
+        /* Send what the applications queued, and poll for ports with room to receive */
+        int blocked = 0;
+        items[0] = (zmq_pollitem_t){ NULL, reactor_wake_fd, ZMQ_POLLIN, 0 };
+        for (size_t i = 0; i < count; ++i) {
+            struct transport_reactor_link *l = polled[i];
+            zmq_msg_t msg;
+            zmq_msg_init(&msg);
+            while (queue_pop(&l->tx, &msg)) {
+                socket_send(l->port, &msg);
+                zmq_msg_init(&msg);
+            }
+            zmq_msg_close(&msg);
+            int full = queue_full(&l->rx);
+            blocked |= full;
+            items[i + 1] = (zmq_pollitem_t){ l->port->zmq_sock, 0, full ? 0 : ZMQ_POLLIN, 0 };
+        }
+
+        /* A full RX queue leaves messages in the socket; retry shortly */
+        if (zmq_poll(items, (int)count + 1, blocked ? 1 : -1) < 0) {
+            if (zmq_errno() == ETERM) break;
+            continue;
+        }
+        if (items[0].revents & ZMQ_POLLIN) {
+            uint64_t value;
+            if (read(reactor_wake_fd, &value, sizeof(value)) < 0) {
+                simulith_log("transport reactor: wake read failed\n");
+            }
+        }
+        for (size_t i = 0; i < count; ++i) {
+            if (!(items[i + 1].revents & ZMQ_POLLIN)) continue;
+            struct transport_reactor_link *l = polled[i];
+            while (!queue_full(&l->rx)) {
+                zmq_msg_t msg;
+                zmq_msg_init(&msg);
+                if (zmq_msg_recv(&msg, l->port->zmq_sock, ZMQ_DONTWAIT) < 0) {
+                    zmq_msg_close(&msg);
+                    break;
+                }
+                queue_push(&l->rx, &msg);
+                zmq_msg_close(&msg);
+            }
+        }
+    }
+    free(items);
+    free(polled);
+    return NULL;
+}
+
+/* Bump the generation and wait until the reactor thread has applied it.
+ * Called with reactor_lock held. */
+static void reactor_sync(void)
+{
+    uint64_t gen = atomic_fetch_add(&reactor_gen, 1) + 1;
+    reactor_wake();
+    while (reactor_acked < gen) {
+        pthread_cond_wait(&reactor_cond, &reactor_lock);
+    }
+}
+
+/* Hand the port's socket to the reactor if it is running */
+static int reactor_attach(transport_port_t *port)
+{
+    port->state->reactor = NULL;
+    pthread_mutex_lock(&reactor_lock);
+    if (!reactor_running) {
+        pthread_mutex_unlock(&reactor_lock);
+        return 0;
+    }
+    struct transport_reactor_link *link = calloc(1, sizeof(*link));
+    if (!link) {
+        pthread_mutex_unlock(&reactor_lock);
+        return -1;
+    }
+    link->port = port;
+    link->next = reactor_links;
+    reactor_links = link;
+    port->state->reactor = link;
+    reactor_sync();
+    pthread_mutex_unlock(&reactor_lock);
+    return 0;
+}
+
+/* Take the port's socket back from the reactor, sending anything still queued */
+static void reactor_detach(transport_port_t *port)
+{
+    struct transport_reactor_link *link = port->state->reactor;
+    if (!link) return;
+
+    pthread_mutex_lock(&reactor_lock);
+    struct transport_reactor_link **pp = &reactor_links;
+    while (*pp != link) pp = &(*pp)->next;
+    *pp = link->next;
+    reactor_sync();
+    pthread_mutex_unlock(&reactor_lock);
+
+    port->state->reactor = NULL;
+    zmq_msg_t msg;
+    zmq_msg_init(&msg);
+    while (queue_pop(&link->tx, &msg)) {
+        socket_send(port, &msg);
+        zmq_msg_init(&msg);
+    }
+    while (queue_pop(&link->rx, &msg)) {
+        zmq_msg_close(&msg);
+        zmq_msg_init(&msg);
+    }
+    zmq_msg_close(&msg);
+    free(link);
+}
+
+int simulith_transport_reactor_start(void)
+{
+    pthread_mutex_lock(&reactor_lock);
+    if (reactor_running) {
+        pthread_mutex_unlock(&reactor_lock);
+        return SIMULITH_TRANSPORT_SUCCESS;
+    }
+    reactor_wake_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (reactor_wake_fd < 0) {
+        pthread_mutex_unlock(&reactor_lock);
+        simulith_log("simulith_transport_reactor_start: eventfd failed\n");
+        return SIMULITH_TRANSPORT_ERROR;
+    }
+    atomic_store(&reactor_stop, 0);
+    if (pthread_create(&reactor_thread, NULL, reactor_main, NULL) != 0) {
+        close(reactor_wake_fd);
+        reactor_wake_fd = -1;
+        pthread_mutex_unlock(&reactor_lock);
+        simulith_log("simulith_transport_reactor_start: Failed to start thread\n");
+        return SIMULITH_TRANSPORT_ERROR;
+    }
+    reactor_running = 1;
+    pthread_mutex_unlock(&reactor_lock);
+    return SIMULITH_TRANSPORT_SUCCESS;
+}
+
+int simulith_transport_reactor_stop(void)
+{
+    pthread_mutex_lock(&reactor_lock);
+    if (!reactor_running) {
+        pthread_mutex_unlock(&reactor_lock);
+        return SIMULITH_TRANSPORT_SUCCESS;
+    }
+    if (reactor_links) {
+        pthread_mutex_unlock(&reactor_lock);
+        simulith_log("simulith_transport_reactor_stop: Ports still attached\n");
+        return SIMULITH_TRANSPORT_ERROR;
+    }
+    reactor_running = 0;
+    atomic_store(&reactor_stop, 1);
+    reactor_wake();
+    pthread_mutex_unlock(&reactor_lock);
+
+    pthread_join(reactor_thread, NULL);
+    close(reactor_wake_fd);
+    reactor_wake_fd = -1;
+    return SIMULITH_TRANSPORT_SUCCESS;
+}
+
+/* Bytes in the ring, including any a link model has not delivered yet */
+static size_t rx_used(const transport_port_t *port)
+{
+    return port->state->rx_tail - port->state->rx_head;
+}
+
+/* Bytes the application may read */
+static size_t rx_avail(const transport_port_t *port)
+{
+    return port->state->rx_limit - port->state->rx_head;
+}
+
+static size_t rx_frames_used(const transport_port_t *port)
+{
+    return port->state->rx_frame_tail - port->state->rx_frame_head;
+}
+
+/* Messages the application may read; stamped ones wait until they are due */
+static size_t rx_frames_visible(const transport_port_t *port)
+{
+    return port->state->rx_frame_limit - port->state->rx_frame_head;
+}
+
+/* Append len bytes at the tail; the caller checks for space */
+static void rx_write(transport_port_t *port, const uint8_t *data, size_t len)
+{
+    size_t off   = port->state->rx_tail & (port->state->rx_buf_size - 1);
+    size_t first = port->state->rx_buf_size - off;
+    if (first > len) first = len;
+    memcpy(port->state->rx_buf + off, data, first);
+    memcpy(port->state->rx_buf, data + first, len - first);
+    port->state->rx_tail += len;
+    if (!port->state->uart_baud && !port->state->stamped) port->state->rx_limit = port->state->rx_tail;
+}
+
+/* Copy up to len bytes from the head without consuming them */
+static size_t rx_read(const transport_port_t *port, uint8_t *data, size_t len)
+{
+    if (port->state->rx_large_valid) {
+        zmq_msg_t *large = (zmq_msg_t *)&port->state->rx_large;
+        size_t left = zmq_msg_size(large) - port->state->rx_large_off;
+        if (len > left) len = left;
+        memcpy(data, (const uint8_t *)zmq_msg_data(large) + port->state->rx_large_off, len);
+        return len;
+    }
+    size_t avail = rx_avail(port);
+    if (len > avail) len = avail;
+    size_t off   = port->state->rx_head & (port->state->rx_buf_size - 1);
+    size_t first = port->state->rx_buf_size - off;
+    if (first > len) first = len;
+    memcpy(data, port->state->rx_buf + off, first);
+    memcpy(data + first, port->state->rx_buf, len - first);
+    return len;
+}
+
+/* Drop up to len bytes from the head, across message boundaries */
+static size_t rx_consume(transport_port_t *port, size_t len)
+{
+    if (port->state->rx_large_valid) {
+        size_t size = zmq_msg_size(&port->state->rx_large);
+        if (len > size - port->state->rx_large_off) len = size - port->state->rx_large_off;
+        port->state->rx_large_off += len;
+        if (port->state->rx_large_off == size) {
+            zmq_msg_close(&port->state->rx_large);
+            port->state->rx_large_valid = 0;
+        }
+        return len;
+    }
+    if (port->state->uart_baud) {
+        /* A UART is a byte stream with no message boundaries */
+        if (len > rx_avail(port)) len = rx_avail(port);
+        port->state->rx_head += len;
+        return len;
+    }
+    size_t done = 0;
+    while (done < len && rx_frames_visible(port) > 0) {
+        uint32_t *left = &port->state->rx_frames[port->state->rx_frame_head & FRAME_MASK];
+        size_t take = len - done;
+        if (take > *left) take = *left;
+        *left -= (uint32_t)take;
+        done += take;
+        if (*left == 0) port->state->rx_frame_head++;
+    }
+    port->state->rx_head += done;
+    return done;
+}
+
+/* Time one byte takes on the wire */
+static uint64_t uart_byte_ns(const transport_port_t *port)
+{
+    uint64_t bits = port->state->uart_frame_bits ? port->state->uart_frame_bits : UART_DEFAULT_FRAME_BITS;
+    return (bits * 1000000000ULL + port->state->uart_baud - 1) / port->state->uart_baud;
+}
+
+/* Deliver the bytes whose last bit has arrived by the current sim time into
+ * the RX FIFO. Bytes that find the FIFO full are lost, as on real hardware. */
+static void uart_release(transport_port_t *port)
+{
+    size_t in_flight = port->state->rx_tail - port->state->rx_limit;
+    if (in_flight == 0) return;
+
+    uint64_t now = atomic_load_explicit(&transport_time_ns, memory_order_relaxed);
+    size_t done = in_flight;
+    if (now < port->state->uart_line_free_ns) {
+        uint64_t byte_ns = uart_byte_ns(port);
+        uint64_t still = (port->state->uart_line_free_ns - now + byte_ns - 1) / byte_ns;
+        done = still >= in_flight ? 0 : in_flight - (size_t)still;
+    }
+
+    size_t fifo = rx_avail(port);
+    size_t room = done;
+    if (port->state->uart_fifo_depth) {
+        room = port->state->uart_fifo_depth > fifo ? port->state->uart_fifo_depth - fifo : 0;
+    }
+    size_t take = done < room ? done : room;
+    size_t lost = done - take;
+    port->state->rx_limit += take;
+    if (lost) {
+        /* Drop the overrun bytes by moving the (short) FIFO over them */
+        size_t mask = port->state->rx_buf_size - 1;
+        fifo += take;
+        for (size_t i = fifo; i-- > 0;) {
+            port->state->rx_buf[(port->state->rx_head + lost + i) & mask] = port->state->rx_buf[(port->state->rx_head + i) & mask];
+        }
+        port->state->rx_head += lost;
+        port->state->rx_limit += lost;
+        stat_add(&port->state->stats->uart_overruns, lost);
+        simulith_log("  RX[%s]: UART overrun, %zu bytes lost\n", port->name, lost);
+    }
+}
+
+/* Make stamped messages readable once sim time reaches their due time. They
+ * are released in arrival order, which is the sender's order. */
+static void stamp_release(transport_port_t *port)
+{
+    uint64_t now = atomic_load_explicit(&transport_time_ns, memory_order_relaxed);
+    while (port->state->rx_frame_limit != port->state->rx_frame_tail &&
+           port->state->rx_due[port->state->rx_frame_limit & FRAME_MASK] <= now) {
+        port->state->rx_limit += port->state->rx_frames[port->state->rx_frame_limit & FRAME_MASK];
+        port->state->rx_frame_limit++;
+    }
+}
+
+/* Bring the readable part of the ring up to the current sim time */
+static void rx_release(transport_port_t *port)
+{
+    if (port->state->uart_baud) {
+        uart_release(port);
+    } else if (port->state->stamped) {
+        stamp_release(port);
+    }
+}
+
+/* Copy a received message into the ring. Returns 0 if there is no room yet. */
+static int rx_ingest(transport_port_t *port, zmq_msg_t *msg)
+{
+    const uint8_t *data = zmq_msg_data(msg);
+    size_t size = zmq_msg_size(msg);
+    uint64_t due_ns = 0;
+    if (port->state->stamped) {
+        simulith_transport_stamp_t stamp;
+        if (size < sizeof(stamp)) {
+            stamp.magic = 0;
+        } else {
+            memcpy(&stamp, data, sizeof(stamp));
+        }
+        if (stamp.magic != SIMULITH_TRANSPORT_STAMP_MAGIC) {
+            simulith_log("  RX[%s]: Dropping %zu byte message without a stamp\n", port->name, size);
+            stat_add(&port->state->stats->rx_dropped, 1);
+            return 1;
+        }
+        data += sizeof(stamp);
+        size -= sizeof(stamp);
+        if (size > port->state->rx_buf_size - rx_used(port) ||
+            (!port->state->uart_baud && rx_frames_used(port) == SIMULITH_TRANSPORT_MAX_FRAMES)) {
+            return 0;
+        }
+        /* Sequence numbers count every message sent, so a jump means some were lost */
+        if (port->state->rx_seq_valid && (int32_t)(stamp.seq - port->state->rx_seq_next) > 0) {
+            uint32_t missed = stamp.seq - port->state->rx_seq_next;
+            stat_add(&port->state->stats->rx_gaps, missed);
+            simulith_log("  RX[%s]: %u messages missing before seq %u\n", port->name, missed, stamp.seq);
+        }
+        port->state->rx_seq_next = stamp.seq + 1;
+        port->state->rx_seq_valid = 1;
+        due_ns = stamp.sim_ns + port->state->delivery_delay_ns;
+        if (port->state->latency_sample && stamp.seq % port->state->latency_sample == 0) {
+            uint64_t now = monotonic_ns();
+            pthread_mutex_lock(&port->state->stats->latency_lock);
+            simulith_histogram_record(&port->state->stats->latency, now > stamp.mono_ns ? now - stamp.mono_ns : 0);
+            pthread_mutex_unlock(&port->state->stats->latency_lock);
+        }
+    }
+    if (size > port->state->rx_buf_size - rx_used(port)) {
+        return 0;
+    }
+    if (port->state->uart_baud) {
+        /* The bytes start shifting in now, or when the line frees up */
+        uint64_t now = atomic_load_explicit(&transport_time_ns, memory_order_relaxed);
+        if (port->state->uart_line_free_ns < now) port->state->uart_line_free_ns = now;
+        port->state->uart_line_free_ns += size * uart_byte_ns(port);
+    } else {
+        if (rx_frames_used(port) == SIMULITH_TRANSPORT_MAX_FRAMES) return 0;
+        port->state->rx_due[port->state->rx_frame_tail & FRAME_MASK] = due_ns;
+        port->state->rx_frames[port->state->rx_frame_tail++ & FRAME_MASK] = (uint32_t)size;
+        if (!port->state->stamped) port->state->rx_frame_limit = port->state->rx_frame_tail;
+    }
+    rx_write(port, data, size);
+    stat_add(&port->state->stats->rx_msgs, 1);
+    stat_add(&port->state->stats->rx_bytes, size);
+    return 1;
+}
+
+/* Reallocate the ring to at least need bytes, within rx_buf_max, keeping
+ * what it holds. Returns 0 if it may not grow that far. */
+static int rx_grow(transport_port_t *port, size_t need)
+{
+    if (need <= port->state->rx_buf_size) return 1;
+    if (need > port->state->rx_buf_max) return 0;
+    size_t size = port->state->rx_buf_size;
+    while (size < need) size <<= 1;
+    uint8_t *buf = malloc(size);
+    if (!buf) return 0;
+
+    size_t used  = rx_used(port);
+    size_t off   = port->state->rx_head & (port->state->rx_buf_size - 1);
+    size_t first = port->state->rx_buf_size - off;
+    if (first > used) first = used;
+    memcpy(buf, port->state->rx_buf + off, first);
+    memcpy(buf + first, port->state->rx_buf, used - first);
+    free(port->state->rx_buf);
+    port->state->rx_buf = buf;
+    port->state->rx_buf_size = size;
+    port->state->rx_limit -= port->state->rx_head;
+    port->state->rx_tail = used;
+    port->state->rx_head = 0;
+    simulith_log("  RX[%s]: Ring grown to %zu bytes\n", port->name, size);
+    return 1;
+}
+
+/* Take a received message into the ring, growing it if allowed. One still
+ * too big is streamed or dropped. Returns 0 if the message has to wait. */
+static int rx_accept(transport_port_t *port, zmq_msg_t *msg)
+{
+    if (port->state->rx_large_valid) return 0;
+
+    size_t size = zmq_msg_size(msg);
+    size_t hdr = port->state->stamped ? sizeof(simulith_transport_stamp_t) : 0;
+    size = size > hdr ? size - hdr : 0;
+    if (port->state->rx_buf_max && size > port->state->rx_buf_size - rx_used(port)) {
+        /* Room for everything if allowed, else at least for this message once read up to it */
+        if (!rx_grow(port, rx_used(port) + size)) rx_grow(port, size);
+    }
+    if (size <= port->state->rx_buf_size) {
+        return rx_ingest(port, msg);
+    }
+
+    if (port->state->rx_stream && !port->state->stamped && !port->state->uart_baud) {
+        /* Lend it in place once everything received before it has been read */
+        if (rx_used(port) > 0) return 0;
+        zmq_msg_init(&port->state->rx_large);
+        zmq_msg_move(&port->state->rx_large, msg);
+        port->state->rx_large_valid = 1;
+        port->state->rx_large_off = 0;
+        stat_add(&port->state->stats->rx_msgs, 1);
+        stat_add(&port->state->stats->rx_bytes, size);
+        return 1;
+    }
+    simulith_log("  RX[%s]: Buffer overflow, dropping %zu bytes\n", port->name, size + hdr);
+    stat_add(&port->state->stats->rx_dropped, 1);
+    return 1;
+}
+
+/* Move every queued message into the ring until it is full */
+static void rx_drain(transport_port_t *port)
+{
+    if (port->state->rx_pending_valid) {
+        if (!rx_accept(port, &port->state->rx_pending)) return;
+        zmq_msg_close(&port->state->rx_pending);
+        port->state->rx_pending_valid = 0;
+    }
+    for (;;) {
+        zmq_msg_t msg;
+        zmq_msg_init(&msg);
+        int rcv_size = rx_next(port, &msg);
+        if (rcv_size < 0) {
+            zmq_msg_close(&msg);
+            return;
+        }
+        size_t size = (size_t)rcv_size;
+        if (size == 0) {
+            zmq_msg_close(&msg);
+            continue;
+        }
+        if (!rx_accept(port, &msg)) {
+            /* Keep it for when the application has read enough to make room */
+            if (!port->state->rx_large_valid) stat_add(&port->state->stats->rx_overflows, 1);
+            zmq_msg_init(&port->state->rx_pending);
+            zmq_msg_move(&port->state->rx_pending, &msg);
+            zmq_msg_close(&msg);
+            port->state->rx_pending_valid = 1;
+            return;
+        }
+        zmq_msg_close(&msg);
+    }
+}
+
+static void rx_free(transport_port_t *port)
+{
+    struct transport_port_state *st = port->state;
+    if (!st) return;
+    if (st->rx_pending_valid) zmq_msg_close(&st->rx_pending);
+    if (st->rx_large_valid) zmq_msg_close(&st->rx_large);
+    free(st->rx_buf);
+    stats_destroy(st->stats);
+    free(st);
+    port->state = NULL;
+}
+
+/* Check settings that are out of range or do not go together */
+static int config_check(const simulith_transport_config_t *config)
+{
+    if (config->mode != SIMULITH_TRANSPORT_PAIR && config->mode != SIMULITH_TRANSPORT_BUS_MASTER &&
+        config->mode != SIMULITH_TRANSPORT_BUS_DEVICE) {
+        simulith_log("simulith_transport_init: Unknown port mode %d\n", config->mode);
+        return -1;
+    }
+    if (config->rx_buf_size > RX_BUF_LIMIT || config->rx_buf_max > RX_BUF_LIMIT) {
+        simulith_log("simulith_transport_init: RX ring larger than %zu bytes\n", RX_BUF_LIMIT);
+        return -1;
+    }
+    if (config->uart_frame_bits && (config->uart_frame_bits < 7 || config->uart_frame_bits > 13)) {
+        /* Start bit, 5 to 9 data bits, parity and 1 or 2 stop bits */
+        simulith_log("simulith_transport_init: UART frame of %u bits\n", (unsigned)config->uart_frame_bits);
+        return -1;
+    }
+    if (config->stamped && config->mode != SIMULITH_TRANSPORT_PAIR) {
+        /* The broker routes on the first bytes of each message */
+        simulith_log("simulith_transport_init: Stamped frames need a point-to-point port\n");
+        return -1;
+    }
+    if (config->rx_stream && (config->stamped || config->uart_baud)) {
+        /* Both release messages from the ring, which streamed messages bypass */
+        simulith_log("simulith_transport_init: Streaming is not for stamped or UART ports\n");
+        return -1;
+    }
+    return 0;
+}
+
+void simulith_transport_set_time(uint64_t sim_time_ns)
+{
+    atomic_store_explicit(&transport_time_ns, sim_time_ns, memory_order_relaxed);
+}
 
 int simulith_transport_init(transport_port_t *port)
 {
+    return simulith_transport_init_config(port, NULL);
+}
+
+int simulith_transport_init_config(transport_port_t *port, const simulith_transport_config_t *config)
+{
+    static const simulith_transport_config_t defaults = { 0 };
     if (!port) return SIMULITH_TRANSPORT_ERROR;
     if (port->init == SIMULITH_TRANSPORT_INITIALIZED) return SIMULITH_TRANSPORT_SUCCESS;
+    if (!config) config = &defaults;
+    if (config_check(config) != 0) return SIMULITH_TRANSPORT_ERROR;
+
+    struct transport_port_state *st = calloc(1, sizeof(*st));
+    if (!st) {
+        simulith_log("simulith_transport_init: Failed to allocate port state\n");
+        return SIMULITH_TRANSPORT_ERROR;
+    }
+    port->state = st;
+    st->mode = config->mode;
+    st->bus_addr = config->bus_addr;
+    st->rx_stream = config->rx_stream;
+    st->uart_baud = config->uart_baud;
+    st->uart_frame_bits = config->uart_frame_bits;
+    st->uart_fifo_depth = config->uart_fifo_depth;
+    st->stamped = config->stamped;
+    st->delivery_delay_ns = config->delivery_delay_ns;
+    st->latency_sample = config->latency_sample;
 
-    port->zmq_ctx = zmq_ctx_new();
+    /* Initialize RX buffer */
+    size_t size = config->rx_buf_size ? config->rx_buf_size : SIMULITH_TRANSPORT_BUFFER_SIZE;
+    st->rx_buf_size = 1;
+    while (st->rx_buf_size < size) st->rx_buf_size <<= 1;
+    if (config->rx_buf_max) {
+        st->rx_buf_max = st->rx_buf_size;
+        while (st->rx_buf_max < config->rx_buf_max) st->rx_buf_max <<= 1;
+    }
+    st->rx_buf = malloc(st->rx_buf_size);
+    st->stats = stats_create(port->name);
+    if (!st->rx_buf || !st->stats) {
+        simulith_log("simulith_transport_init: Failed to allocate %zu byte RX buffer\n", st->rx_buf_size);
+        rx_free(port);
+        return SIMULITH_TRANSPORT_ERROR;
+    }
+
+    port->zmq_ctx = simulith_context_acquire();
     if (!port->zmq_ctx) {
         simulith_log("simulith_transport_init: Failed to create ZMQ context\n");
+        rx_free(port);
         return SIMULITH_TRANSPORT_ERROR;
     }
-    port->zmq_sock = zmq_socket(port->zmq_ctx, ZMQ_PAIR);
+    int bus = port->state->mode == SIMULITH_TRANSPORT_BUS_MASTER || port->state->mode == SIMULITH_TRANSPORT_BUS_DEVICE;
+    port->zmq_sock = zmq_socket(port->zmq_ctx, bus ? ZMQ_DEALER : ZMQ_PAIR);
     if (!port->zmq_sock) {
         simulith_log("simulith_transport_init: Failed to create ZMQ socket\n");
-        zmq_ctx_term(port->zmq_ctx);
+        simulith_context_release();
+        rx_free(port);
         return SIMULITH_TRANSPORT_ERROR;
     }
-    if (strlen(port->name) > 0) {
+    if (port->state->mode == SIMULITH_TRANSPORT_BUS_DEVICE) {
+        /* The broker routes to devices by this identity */
+        uint8_t id[3] = { BUS_DEVICE_TAG, (uint8_t)(port->state->bus_addr >> 8), (uint8_t)port->state->bus_addr };
+        zmq_setsockopt(port->zmq_sock, ZMQ_IDENTITY, id, sizeof(id));
+    } else if (strlen(port->name) > 0) {
         zmq_setsockopt(port->zmq_sock, ZMQ_IDENTITY, port->name, strlen(port->name));
     }
     int rc;
-    if (port->is_server) {
-        rc = zmq_bind(port->zmq_sock, port->address);
+    if (port->is_server && !bus) {
+        rc = bind_with_alias(port->zmq_sock, port, port->address);
         if (rc != 0) {
             simulith_log("simulith_transport_init: Failed to bind to %s\n", port->address);
             zmq_close(port->zmq_sock);
-            zmq_ctx_term(port->zmq_ctx);
+            simulith_context_release();
+            rx_free(port);
             return SIMULITH_TRANSPORT_ERROR;
         }
         simulith_log("simulith_transport_init: Bound to %s as '%s'\n", port->address, port->name);
+    } else if (inproc_enabled() && bound_here(port->address)) {
+        char alias[sizeof(port->address) + 32];
+        inproc_alias(port->address, alias, sizeof(alias));
+        rc = zmq_connect(port->zmq_sock, alias);
+        if (rc != 0) {
+            simulith_log("simulith_transport_init: Failed to connect to %s\n", alias);
+            zmq_close(port->zmq_sock);
+            simulith_context_release();
+            rx_free(port);
+            return SIMULITH_TRANSPORT_ERROR;
+        }
+        simulith_log("simulith_transport_init: Connected to %s in-process as '%s'\n", port->address, port->name);
     } else {
         rc = zmq_connect(port->zmq_sock, port->address);
         if (rc != 0) {
             simulith_log("simulith_transport_init: Failed to connect to %s\n", port->address);
             zmq_close(port->zmq_sock);
-            zmq_ctx_term(port->zmq_ctx);
+            simulith_context_release();
+            rx_free(port);
             return SIMULITH_TRANSPORT_ERROR;
         }
         simulith_log("simulith_transport_init: Connected to %s as '%s'\n", port->address, port->name);
     }
+    if (reactor_attach(port) != 0) {
+        simulith_log("simulith_transport_init: Failed to attach %s to the reactor\n", port->name);
+        bound_remove(port);
+        zmq_close(port->zmq_sock);
+        simulith_context_release();
+        rx_free(port);
+        return SIMULITH_TRANSPORT_ERROR;
+    }
+    capture_attach(port);
     port->init = SIMULITH_TRANSPORT_INITIALIZED;
-
-    /* Initialize RX buffer */
-    port->rx_buf_len = 0;
     return SIMULITH_TRANSPORT_SUCCESS;
 }
 
@@ -56,13 +1254,45 @@ int simulith_transport_send(transport_port_t *port, const uint8_t *data, size_t
         simulith_log("simulith_transport_send: Uninitialized transport port\n");
         return SIMULITH_TRANSPORT_ERROR;
     }
-    int rc = zmq_send(port->zmq_sock, data, len, ZMQ_DONTWAIT);
-    if (rc < 0) {
-        simulith_log("simulith_transport_send: zmq_send failed (peer may be unavailable)\n");
+    size_t hdr = port->state->stamped ? sizeof(simulith_transport_stamp_t) : 0;
+    zmq_msg_t msg;
+    if (zmq_msg_init_size(&msg, len + hdr) != 0) {
         return SIMULITH_TRANSPORT_ERROR;
     }
-    simulith_log("  TX[%s]: %zu bytes\n", port->name, len);
-    return (int)len;
+    if (port->state->stamped) {
+        simulith_transport_stamp_t stamp = {
+            .magic = SIMULITH_TRANSPORT_STAMP_MAGIC,
+            .seq = port->state->tx_seq++,
+            .sim_ns = atomic_load_explicit(&transport_time_ns, memory_order_relaxed),
+            .mono_ns = monotonic_ns(),
+        };
+        memcpy(zmq_msg_data(&msg), &stamp, hdr);
+    }
+    memcpy((uint8_t *)zmq_msg_data(&msg) + hdr, data, len);
+    int rc = tx_msg(port, &msg);
+    return rc < 0 ? rc : (int)len;
+}
+
+int simulith_transport_send_zc(transport_port_t *port, uint8_t *data, size_t len, simulith_transport_free_fn *ffn, void *hint)
+{
+    if (!port || port->init != SIMULITH_TRANSPORT_INITIALIZED) {
+        simulith_log("simulith_transport_send_zc: Uninitialized transport port\n");
+        if (ffn) ffn(data, hint);
+        return SIMULITH_TRANSPORT_ERROR;
+    }
+    if (port->state->stamped) {
+        /* The stamp has to precede the payload, so copy it after all */
+        int rc = simulith_transport_send(port, data, len);
+        if (ffn) ffn(data, hint);
+        return rc;
+    }
+    zmq_msg_t msg;
+    if (zmq_msg_init_data(&msg, data, len, ffn, hint) != 0) {
+        if (ffn) ffn(data, hint);
+        return SIMULITH_TRANSPORT_ERROR;
+    }
+    /* On failure the message is closed, which hands the buffer back through ffn */
+    return tx_msg(port, &msg);
 }
 
 int simulith_transport_receive(transport_port_t *port, uint8_t *data, size_t max_len)
@@ -71,54 +1301,203 @@ int simulith_transport_receive(transport_port_t *port, uint8_t *data, size_t max
         simulith_log("simulith_transport_receive: Uninitialized transport port\n");
         return SIMULITH_TRANSPORT_ERROR;
     }
-    if (port->rx_buf_len == 0) {
+    if (port->state->rx_large_valid) {
+        /* A streamed message comes out in chunks of up to max_len */
+        size_t to_copy = rx_read(port, data, max_len);
+        rx_consume(port, to_copy);
+        return (int)to_copy;
+    }
+    if (rx_avail(port) == 0) {
         /* No buffered data */
         return 0;
     }
-    size_t to_copy = (port->rx_buf_len < max_len) ? port->rx_buf_len : max_len;
-    memcpy(data, port->rx_buf, to_copy);
-    /* Shift remaining data in buffer */
-    if (to_copy < port->rx_buf_len) {
-        memmove(port->rx_buf, port->rx_buf + to_copy, port->rx_buf_len - to_copy);
-    }
-    port->rx_buf_len -= to_copy;
-    simulith_log("  RX[%s]: %zu bytes (from buffer)\n", port->name, to_copy);
+    /* Return at most the rest of the message at the head */
+    size_t left = port->state->uart_baud ? rx_avail(port) : port->state->rx_frames[port->state->rx_frame_head & FRAME_MASK];
+    size_t to_copy = rx_read(port, data, max_len < left ? max_len : left);
+    rx_consume(port, to_copy);
     return (int)to_copy;
 }
 
-int simulith_transport_available(transport_port_t *port)
+int simulith_transport_peek(transport_port_t *port, uint8_t *data, size_t max_len)
 {
     if (!port || port->init != SIMULITH_TRANSPORT_INITIALIZED) {
-        simulith_log("simulith_transport_available: Uninitialized transport port\n");
+        simulith_log("simulith_transport_peek: Uninitialized transport port\n");
+        return SIMULITH_TRANSPORT_ERROR;
+    }
+    return (int)rx_read(port, data, max_len);
+}
+
+int simulith_transport_consume(transport_port_t *port, size_t len)
+{
+    if (!port || port->init != SIMULITH_TRANSPORT_INITIALIZED) {
+        simulith_log("simulith_transport_consume: Uninitialized transport port\n");
+        return SIMULITH_TRANSPORT_ERROR;
+    }
+    return (int)rx_consume(port, len);
+}
+
+int simulith_transport_rx_span(transport_port_t *port, const uint8_t **data)
+{
+    if (!port || port->init != SIMULITH_TRANSPORT_INITIALIZED || !data) {
+        simulith_log("simulith_transport_rx_span: Uninitialized transport port\n");
+        return SIMULITH_TRANSPORT_ERROR;
+    }
+    if (port->state->rx_large_valid) {
+        *data = (const uint8_t *)zmq_msg_data(&port->state->rx_large) + port->state->rx_large_off;
+        return (int)(zmq_msg_size(&port->state->rx_large) - port->state->rx_large_off);
+    }
+    size_t off = port->state->rx_head & (port->state->rx_buf_size - 1);
+    size_t len = port->state->rx_buf_size - off;
+    if (len > rx_avail(port)) len = rx_avail(port);
+    *data = port->state->rx_buf + off;
+    return (int)len;
+}
+
+int simulith_transport_borrow(transport_port_t *port, simulith_transport_view_t *view)
+{
+    if (!port || port->init != SIMULITH_TRANSPORT_INITIALIZED || !view) {
+        simulith_log("simulith_transport_borrow: Uninitialized transport port\n");
         return SIMULITH_TRANSPORT_ERROR;
     }
-    /* If buffer already has data, report available */
-    if (port->rx_buf_len > 0) {
+    view->port = NULL;
+    view->has_msg = 0;
+
+    if (port->state->uart_baud) {
+        /* Everything goes through the link model; lend what has arrived */
+        rx_drain(port);
+        rx_release(port);
+        int len = simulith_transport_rx_span(port, &view->data);
+        if (len <= 0) return 0;
+        view->len = (size_t)len;
+        view->port = port;
         return 1;
     }
-    zmq_pollitem_t items[] = { { port->zmq_sock, 0, ZMQ_POLLIN, 0 } };
-    int rc = zmq_poll(items, 1, 0);
-    if (rc > 0 && (items[0].revents & ZMQ_POLLIN)) {
-        zmq_msg_t msg;
-        zmq_msg_init(&msg);
-        int rcv_size = zmq_msg_recv(&msg, port->zmq_sock, ZMQ_DONTWAIT);
-        if (rcv_size > 0) {
-            size_t size = (size_t)rcv_size;
-            size_t space = sizeof(port->rx_buf) - port->rx_buf_len;
-            if (size > space) {
-                simulith_log("  RX[%s]: Buffer overflow, dropping %zu bytes\n", port->name, size);
-                zmq_msg_close(&msg);
-                return 0;
-            }
-            memcpy(port->rx_buf + port->rx_buf_len, zmq_msg_data(&msg), size);
-            port->rx_buf_len += size;
-            zmq_msg_close(&msg);
-            simulith_log("  RX[%s]: %zu bytes buffered\n", port->name, size);
+
+    if (port->state->stamped) {
+        /* Only messages that are due may be lent, and they all go through the ring */
+        rx_drain(port);
+        rx_release(port);
+        if (rx_frames_visible(port) == 0) return 0;
+    }
+
+    if (port->state->rx_large_valid) {
+        /* A streamed message is lent as it is, ahead of anything held behind it */
+        int len = simulith_transport_rx_span(port, &view->data);
+        view->len = (size_t)len;
+        view->port = port;
+        return 1;
+    }
+
+    /* Buffered data comes first, in place unless the message wraps the ring */
+    if (rx_frames_visible(port) > 0) {
+        size_t left = port->state->rx_frames[port->state->rx_frame_head & FRAME_MASK];
+        size_t off = port->state->rx_head & (port->state->rx_buf_size - 1);
+        if (off + left <= port->state->rx_buf_size) {
+            view->data = port->state->rx_buf + off;
+            view->len = left;
+            view->port = port;
             return 1;
         }
-        zmq_msg_close(&msg);
+        if (zmq_msg_init_size(&view->msg, left) != 0) {
+            return SIMULITH_TRANSPORT_ERROR;
+        }
+        rx_read(port, zmq_msg_data(&view->msg), left);
+        rx_consume(port, left);
+    } else if (port->state->rx_pending_valid) {
+        zmq_msg_init(&view->msg);
+        zmq_msg_move(&view->msg, &port->state->rx_pending);
+        zmq_msg_close(&port->state->rx_pending);
+        port->state->rx_pending_valid = 0;
+        stat_add(&port->state->stats->rx_msgs, 1);
+        stat_add(&port->state->stats->rx_bytes, zmq_msg_size(&view->msg));
+    } else {
+        zmq_msg_init(&view->msg);
+        int rcv_size;
+        do {
+            /* Skip empty messages, as available() does */
+            rcv_size = rx_next(port, &view->msg);
+        } while (rcv_size == 0);
+        if (rcv_size < 0) {
+            zmq_msg_close(&view->msg);
+            return 0;
+        }
+        stat_add(&port->state->stats->rx_msgs, 1);
+        stat_add(&port->state->stats->rx_bytes, (uint64_t)rcv_size);
     }
-    return 0;
+    view->has_msg = 1;
+    view->data = zmq_msg_data(&view->msg);
+    view->len = zmq_msg_size(&view->msg);
+    return 1;
+}
+
+void simulith_transport_release(simulith_transport_view_t *view)
+{
+    if (!view) return;
+    if (view->port) {
+        rx_consume(view->port, view->len);
+        view->port = NULL;
+    }
+    if (view->has_msg) {
+        zmq_msg_close(&view->msg);
+        view->has_msg = 0;
+    }
+    view->data = NULL;
+    view->len = 0;
+}
+
+int simulith_transport_available(transport_port_t *port)
+{
+    if (!port || port->init != SIMULITH_TRANSPORT_INITIALIZED) {
+        simulith_log("simulith_transport_available: Uninitialized transport port\n");
+        return SIMULITH_TRANSPORT_ERROR;
+    }
+    /* Pull in everything queued, not just one message per call */
+    rx_drain(port);
+    rx_release(port);
+    return rx_avail(port) > 0 || port->state->rx_large_valid ? 1 : 0;
+}
+
+int simulith_transport_get_stats(const transport_port_t *port, simulith_transport_stats_t *stats)
+{
+    if (!port || port->init != SIMULITH_TRANSPORT_INITIALIZED || !stats) {
+        return SIMULITH_TRANSPORT_ERROR;
+    }
+    stats_read(port->state->stats, stats);
+    return SIMULITH_TRANSPORT_SUCCESS;
+}
+
+void simulith_transport_reset_stats(transport_port_t *port)
+{
+    if (!port || port->init != SIMULITH_TRANSPORT_INITIALIZED) return;
+    struct transport_port_stats *stats = port->state->stats;
+    atomic_store_explicit(&stats->tx_msgs, 0, memory_order_relaxed);
+    atomic_store_explicit(&stats->tx_bytes, 0, memory_order_relaxed);
+    atomic_store_explicit(&stats->tx_errors, 0, memory_order_relaxed);
+    atomic_store_explicit(&stats->rx_msgs, 0, memory_order_relaxed);
+    atomic_store_explicit(&stats->rx_bytes, 0, memory_order_relaxed);
+    atomic_store_explicit(&stats->rx_dropped, 0, memory_order_relaxed);
+    atomic_store_explicit(&stats->rx_overflows, 0, memory_order_relaxed);
+    atomic_store_explicit(&stats->rx_gaps, 0, memory_order_relaxed);
+    atomic_store_explicit(&stats->uart_overruns, 0, memory_order_relaxed);
+    pthread_mutex_lock(&stats->latency_lock);
+    memset(&stats->latency, 0, sizeof(stats->latency));
+    pthread_mutex_unlock(&stats->latency_lock);
+}
+
+int simulith_transport_foreach_stats(simulith_transport_stats_fn *fn, void *ctx)
+{
+    int count = 0;
+    pthread_mutex_lock(&stats_lock);
+    for (struct transport_port_stats *stats = stats_ports; stats; stats = stats->next) {
+        if (fn) {
+            simulith_transport_stats_t snapshot;
+            stats_read(stats, &snapshot);
+            fn(stats->name, &snapshot, ctx);
+        }
+        count++;
+    }
+    pthread_mutex_unlock(&stats_lock);
+    return count;
 }
 
 int simulith_transport_flush(transport_port_t *port)
@@ -135,9 +1514,201 @@ int simulith_transport_close(transport_port_t *port)
     if (!port || port->init != SIMULITH_TRANSPORT_INITIALIZED) {
         return SIMULITH_TRANSPORT_ERROR;
     }
+    reactor_detach(port);
+    if (port->is_server) {
+        bound_remove(port);
+    }
     zmq_close(port->zmq_sock);
-    zmq_ctx_term(port->zmq_ctx);
+    simulith_context_release();
+    rx_free(port);
     port->init = 0;
     simulith_log("Transport port %s closed\n", port->name);
     return SIMULITH_TRANSPORT_SUCCESS;
 }
+
+int simulith_transport_bus_send(transport_port_t *port, uint16_t addr, const uint8_t *data, size_t len)
+{
+    if (!port || port->init != SIMULITH_TRANSPORT_INITIALIZED || port->state->mode != SIMULITH_TRANSPORT_BUS_MASTER) {
+        simulith_log("simulith_transport_bus_send: Not an initialized bus master port\n");
+        return SIMULITH_TRANSPORT_ERROR;
+    }
+    zmq_msg_t msg;
+    if (zmq_msg_init_size(&msg, len + SIMULITH_TRANSPORT_BUS_ADDR_LEN) != 0) {
+        return SIMULITH_TRANSPORT_ERROR;
+    }
+    uint8_t *out = zmq_msg_data(&msg);
+    out[0] = (uint8_t)(addr >> 8);
+    out[1] = (uint8_t)addr;
+    memcpy(out + SIMULITH_TRANSPORT_BUS_ADDR_LEN, data, len);
+    int rc = tx_msg(port, &msg);
+    return rc < 0 ? rc : (int)len;
+}
+
+/* Master that last addressed a device, where the device's replies go */
+typedef struct {
+    uint16_t addr;
+    uint8_t master[255];
+    size_t master_len;
+} bus_route_t;
+
+struct simulith_bus_broker {
+    char address[128];
+    void *sock;
+    pthread_t thread;
+    atomic_int stop;
+    bus_route_t *routes;
+    size_t route_count;
+    uint64_t routed;
+    uint64_t dropped;
+};
+
+static bus_route_t *bus_route(simulith_bus_broker_t *broker, uint16_t addr, int create)
+{
+    for (size_t i = 0; i < broker->route_count; ++i) {
+        if (broker->routes[i].addr == addr) return &broker->routes[i];
+    }
+    if (!create) return NULL;
+    bus_route_t *routes = realloc(broker->routes, (broker->route_count + 1) * sizeof(*routes));
+    if (!routes) return NULL;
+    broker->routes = routes;
+    bus_route_t *route = &routes[broker->route_count++];
+    route->addr = addr;
+    route->master_len = 0;
+    return route;
+}
+
+/* Forward one [identity][payload] message between a master and a device */
+static void bus_forward(simulith_bus_broker_t *broker, zmq_msg_t *id, zmq_msg_t *payload)
+{
+    const uint8_t *from = zmq_msg_data(id);
+    size_t from_len = zmq_msg_size(id);
+    const uint8_t *data = zmq_msg_data(payload);
+    size_t len = zmq_msg_size(payload);
+    uint8_t to[255];
+    size_t to_len;
+    zmq_msg_t out;
+
+    if (from_len == 3 && from[0] == BUS_DEVICE_TAG) {
+        /* Device reply: to its master, prefixed with the device address */
+        uint16_t addr = (uint16_t)(from[1] << 8 | from[2]);
+        bus_route_t *route = bus_route(broker, addr, 0);
+        if (!route || route->master_len == 0) {
+            broker->dropped++;
+            return;
+        }
+        memcpy(to, route->master, route->master_len);
+        to_len = route->master_len;
+        zmq_msg_init_size(&out, len + SIMULITH_TRANSPORT_BUS_ADDR_LEN);
+        memcpy(zmq_msg_data(&out), from + 1, SIMULITH_TRANSPORT_BUS_ADDR_LEN);
+        memcpy((uint8_t *)zmq_msg_data(&out) + SIMULITH_TRANSPORT_BUS_ADDR_LEN, data, len);
+    } else {
+        /* Master transaction: strip the address and deliver to that device */
+        if (len < SIMULITH_TRANSPORT_BUS_ADDR_LEN || from_len > sizeof(to)) {
+            broker->dropped++;
+            return;
+        }
+        uint16_t addr = (uint16_t)(data[0] << 8 | data[1]);
+        bus_route_t *route = bus_route(broker, addr, 1);
+        if (route) {
+            memcpy(route->master, from, from_len);
+            route->master_len = from_len;
+        }
+        to[0] = BUS_DEVICE_TAG;
+        to[1] = data[0];
+        to[2] = data[1];
+        to_len = 3;
+        zmq_msg_init_size(&out, len - SIMULITH_TRANSPORT_BUS_ADDR_LEN);
+        memcpy(zmq_msg_data(&out), data + SIMULITH_TRANSPORT_BUS_ADDR_LEN, len - SIMULITH_TRANSPORT_BUS_ADDR_LEN);
+    }
+
+    /* ROUTER_MANDATORY makes an absent device fail here instead of vanishing */
+    if (zmq_send(broker->sock, to, to_len, ZMQ_SNDMORE | ZMQ_DONTWAIT) < 0 ||
+        zmq_msg_send(&out, broker->sock, ZMQ_DONTWAIT) < 0) {
+        zmq_msg_close(&out);
+        broker->dropped++;
+        return;
+    }
+    broker->routed++;
+}
+
+static void *bus_broker_main(void *arg)
+{
+    simulith_bus_broker_t *broker = arg;
+    zmq_pollitem_t item = { broker->sock, 0, ZMQ_POLLIN, 0 };
+
+    while (!atomic_load(&broker->stop)) {
+        if (zmq_poll(&item, 1, BUS_POLL_MS) <= 0) continue;
+        for (;;) {
+            zmq_msg_t id, payload;
+            zmq_msg_init(&id);
+            zmq_msg_init(&payload);
+            if (zmq_msg_recv(&id, broker->sock, ZMQ_DONTWAIT) < 0) {
+                zmq_msg_close(&id);
+                zmq_msg_close(&payload);
+                break;
+            }
+            if (zmq_msg_more(&id) && zmq_msg_recv(&payload, broker->sock, 0) >= 0) {
+                bus_forward(broker, &id, &payload);
+            }
+            /* Discard any further frames; bus messages are single-part */
+            while (zmq_msg_more(&payload)) {
+                if (zmq_msg_recv(&payload, broker->sock, 0) < 0) break;
+            }
+            zmq_msg_close(&id);
+            zmq_msg_close(&payload);
+        }
+    }
+    return NULL;
+}
+
+simulith_bus_broker_t *simulith_bus_broker_start(const char *address)
+{
+    if (!address || strlen(address) >= sizeof(((simulith_bus_broker_t *)0)->address)) {
+        simulith_log("simulith_bus_broker_start: Invalid address\n");
+        return NULL;
+    }
+    simulith_bus_broker_t *broker = calloc(1, sizeof(*broker));
+    if (!broker) return NULL;
+    strcpy(broker->address, address);
+
+    void *ctx = simulith_context_acquire();
+    if (!ctx) {
+        free(broker);
+        return NULL;
+    }
+    broker->sock = zmq_socket(ctx, ZMQ_ROUTER);
+    int mandatory = 1;
+    if (!broker->sock ||
+        zmq_setsockopt(broker->sock, ZMQ_ROUTER_MANDATORY, &mandatory, sizeof(mandatory)) != 0 ||
+        bind_with_alias(broker->sock, broker, address) != 0) {
+        simulith_log("simulith_bus_broker_start: Failed to bind to %s\n", address);
+        if (broker->sock) zmq_close(broker->sock);
+        simulith_context_release();
+        free(broker);
+        return NULL;
+    }
+    if (pthread_create(&broker->thread, NULL, bus_broker_main, broker) != 0) {
+        simulith_log("simulith_bus_broker_start: Failed to start thread\n");
+        bound_remove(broker);
+        zmq_close(broker->sock);
+        simulith_context_release();
+        free(broker);
+        return NULL;
+    }
+    simulith_log("simulith_bus_broker_start: Bus broker on %s\n", address);
+    return broker;
+}
+
+void simulith_bus_broker_stop(simulith_bus_broker_t *broker)
+{
+    if (!broker) return;
+    atomic_store(&broker->stop, 1);
+    pthread_join(broker->thread, NULL);
+    simulith_log("Bus broker on %s stopped: %llu routed, %llu dropped\n", broker->address,
+                 (unsigned long long)broker->routed, (unsigned long long)broker->dropped);
+    bound_remove(broker);
+    zmq_close(broker->sock);
+    simulith_context_release();
+    free(broker->routes);
+    free(broker);
+}
@@ -0,0 +1,131 @@
+#include "unity.h"
+#include <pthread.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "simulith.h"
+
+#define TEST_CLOCK_NAME "/simulith_clock_test"
+
+void setUp(void) { }
+void tearDown(void) { }
+
+static void test_clock_publish_and_read(void)
+{
+    TEST_ASSERT_NULL(simulith_clock_open(TEST_CLOCK_NAME));
+
+    simulith_clock_t* writer = simulith_clock_create(TEST_CLOCK_NAME);
+    TEST_ASSERT_NOT_NULL(writer);
+    simulith_clock_t* reader = simulith_clock_open(TEST_CLOCK_NAME);
+    TEST_ASSERT_NOT_NULL(reader);
+
+    // Nothing published yet
+    uint64_t time_ns = 1, interval_ns = 1, seq = 1;
+    TEST_ASSERT_EQUAL_INT(-1, simulith_clock_read(reader, &time_ns, &interval_ns, &seq));
+    TEST_ASSERT_EQUAL_UINT64(0, simulith_clock_now_ns(reader));
+
+    TEST_ASSERT_EQUAL_INT(0, simulith_clock_publish(writer, 10 * INTERVAL_NS, INTERVAL_NS, 1.0));
+    TEST_ASSERT_EQUAL_INT(0, simulith_clock_publish(writer, 11 * INTERVAL_NS, 2 * INTERVAL_NS, 1.0));
+    TEST_ASSERT_EQUAL_INT(0, simulith_clock_read(reader, &time_ns, &interval_ns, &seq));
+    TEST_ASSERT_EQUAL_UINT64(11 * INTERVAL_NS, time_ns);
+    TEST_ASSERT_EQUAL_UINT64(2 * INTERVAL_NS, interval_ns);
+    TEST_ASSERT_EQUAL_UINT64(2, seq);
+    TEST_ASSERT_EQUAL_UINT64(11 * INTERVAL_NS, simulith_clock_now_ns(reader));
+
+    // Readers cannot publish
+    TEST_ASSERT_EQUAL_INT(-1, simulith_clock_publish(reader, 0, 0, 1.0));
+
+    // Closing the publisher removes the name; mapped readers keep the last time
+    simulith_clock_close(writer);
+    TEST_ASSERT_NULL(simulith_clock_open(TEST_CLOCK_NAME));
+    TEST_ASSERT_EQUAL_UINT64(11 * INTERVAL_NS, simulith_clock_now_ns(reader));
+    simulith_clock_close(reader);
+}
+
+static void test_clock_invalid_params(void)
+{
+    TEST_ASSERT_NULL(simulith_clock_create("no_leading_slash"));
+    TEST_ASSERT_NULL(simulith_clock_open(NULL));
+    TEST_ASSERT_EQUAL_INT(-1, simulith_clock_publish(NULL, 0, 0, 1.0));
+    TEST_ASSERT_EQUAL_INT(-1, simulith_clock_read(NULL, NULL, NULL, NULL));
+    TEST_ASSERT_EQUAL_UINT64(0, simulith_clock_interpolated_ns(NULL));
+    simulith_clock_close(NULL);
+}
+
+static void test_clock_interpolation(void)
+{
+    // A NULL name gives a clock private to the process
+    simulith_clock_t* clock = simulith_clock_create(NULL);
+    TEST_ASSERT_NOT_NULL(clock);
+    TEST_ASSERT_EQUAL_UINT64(0, simulith_clock_interpolated_ns(clock));
+
+    // Real time advances sim time at the announced speed, clamped at the next tick
+    const uint64_t tick_ns = 100 * INTERVAL_NS;
+    TEST_ASSERT_EQUAL_INT(0, simulith_clock_publish(clock, tick_ns, 1000000000ULL, 1.0));
+    usleep(20000);
+    uint64_t now_ns = simulith_clock_interpolated_ns(clock);
+    TEST_ASSERT_UINT64_WITHIN(1000000000ULL / 2, tick_ns + 1000000000ULL / 2, now_ns);
+    TEST_ASSERT_GREATER_OR_EQUAL_UINT64(tick_ns + 20000000ULL, now_ns);
+
+    TEST_ASSERT_EQUAL_INT(0, simulith_clock_publish(clock, tick_ns, 1000, 1.0));
+    usleep(1000);
+    TEST_ASSERT_EQUAL_UINT64(tick_ns + 1000, simulith_clock_interpolated_ns(clock));
+
+    // Speed 0 holds time at the tick
+    TEST_ASSERT_EQUAL_INT(0, simulith_clock_publish(clock, tick_ns, INTERVAL_NS, 0.0));
+    usleep(1000);
+    TEST_ASSERT_EQUAL_UINT64(tick_ns, simulith_clock_interpolated_ns(clock));
+    TEST_ASSERT_EQUAL_UINT64(tick_ns, simulith_clock_now_ns(clock));
+
+    simulith_clock_close(clock);
+}
+
+#define WRITES 200000
+
+static void* writer_thread(void* arg)
+{
+    simulith_clock_t* clock = (simulith_clock_t*)arg;
+    for (uint64_t i = 1; i <= WRITES; ++i)
+    {
+        simulith_clock_publish(clock, i * INTERVAL_NS, i, 1.0);
+    }
+    return NULL;
+}
+
+// Readers never see a torn tick while the writer is publishing
+static void test_clock_concurrent_reads_consistent(void)
+{
+    simulith_clock_t* writer = simulith_clock_create(TEST_CLOCK_NAME);
+    simulith_clock_t* reader = simulith_clock_open(TEST_CLOCK_NAME);
+    TEST_ASSERT_NOT_NULL(writer);
+    TEST_ASSERT_NOT_NULL(reader);
+
+    pthread_t thread;
+    pthread_create(&thread, NULL, writer_thread, writer);
+
+    uint64_t last_seq = 0;
+    while (last_seq < WRITES)
+    {
+        uint64_t time_ns, interval_ns, seq;
+        if (simulith_clock_read(reader, &time_ns, &interval_ns, &seq) != 0)
+            continue;
+        TEST_ASSERT_EQUAL_UINT64(interval_ns * INTERVAL_NS, time_ns);
+        TEST_ASSERT_EQUAL_UINT64(seq, interval_ns);
+        TEST_ASSERT_TRUE(seq >= last_seq);
+        last_seq = seq;
+    }
+
+    pthread_join(thread, NULL);
+    simulith_clock_close(reader);
+    simulith_clock_close(writer);
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_clock_publish_and_read);
+    RUN_TEST(test_clock_invalid_params);
+    RUN_TEST(test_clock_interpolation);
+    RUN_TEST(test_clock_concurrent_reads_consistent);
+    return UNITY_END();
+}
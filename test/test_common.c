@@ -137,11 +137,84 @@ static void test_log_file_and_both(void)
     unsetenv("SIMULITH_LOG_MODE");
 }
 
+static void test_tick_frame_decode(void)
+{
+    simulith_tick_frame_t frame;
+    simulith_tick_frame_t sent = { 42, 2 * INTERVAL_NS };
+    TEST_ASSERT_EQUAL_INT(0, simulith_tick_frame_decode(&sent, sizeof(sent), &frame));
+    TEST_ASSERT_EQUAL_UINT64(42, frame.time_ns);
+    TEST_ASSERT_EQUAL_UINT64(2 * INTERVAL_NS, frame.interval_ns);
+
+    // Frames from servers that do not announce a speed run at real time
+    TEST_ASSERT_EQUAL_INT(0, simulith_tick_frame_decode(&sent, offsetof(simulith_tick_frame_t, speed), &frame));
+    TEST_ASSERT_EQUAL_UINT64(2 * INTERVAL_NS, frame.interval_ns);
+    TEST_ASSERT_EQUAL_FLOAT(1.0f, (float)frame.speed);
+
+    // Legacy time-only frame falls back to the default interval
+    uint64_t legacy = 7;
+    TEST_ASSERT_EQUAL_INT(0, simulith_tick_frame_decode(&legacy, sizeof(legacy), &frame));
+    TEST_ASSERT_EQUAL_UINT64(7, frame.time_ns);
+    TEST_ASSERT_EQUAL_UINT64(INTERVAL_NS, frame.interval_ns);
+    TEST_ASSERT_EQUAL_FLOAT(1.0f, (float)frame.speed);
+
+    // Too short to be a tick
+    TEST_ASSERT_EQUAL_INT(-1, simulith_tick_frame_decode(&legacy, 4, &frame));
+    TEST_ASSERT_EQUAL_INT(-1, simulith_tick_frame_decode(NULL, sizeof(legacy), &frame));
+}
+
+static void test_histogram(void)
+{
+    simulith_histogram_t hist;
+    memset(&hist, 0, sizeof(hist));
+    TEST_ASSERT_EQUAL_UINT64(0, simulith_histogram_percentile(&hist, 50.0));
+
+    for (int i = 0; i < 90; ++i)
+        simulith_histogram_record(&hist, 1000); // bucket 9: [512, 1024)
+    for (int i = 0; i < 10; ++i)
+        simulith_histogram_record(&hist, 1000000); // bucket 19: [524288, 1048576)
+    simulith_histogram_record(&hist, 0);
+    simulith_histogram_record(&hist, UINT64_MAX);
+
+    TEST_ASSERT_EQUAL_UINT64(102, hist.count);
+    TEST_ASSERT_EQUAL_UINT64(90, hist.buckets[9]);
+    TEST_ASSERT_EQUAL_UINT64(10, hist.buckets[19]);
+    TEST_ASSERT_EQUAL_UINT64(1, hist.buckets[0]);
+    TEST_ASSERT_EQUAL_UINT64(1, hist.buckets[SIMULITH_HIST_BUCKETS - 1]);
+    TEST_ASSERT_EQUAL_UINT64(UINT64_MAX, hist.max_ns);
+
+    TEST_ASSERT_EQUAL_UINT64(1024, simulith_histogram_percentile(&hist, 50.0));
+    TEST_ASSERT_EQUAL_UINT64(1048576, simulith_histogram_percentile(&hist, 95.0));
+    TEST_ASSERT_EQUAL_UINT64(UINT64_MAX, simulith_histogram_percentile(&hist, 100.0));
+}
+
+static void test_shared_context_refcount(void)
+{
+    void *a = simulith_context_acquire();
+    void *b = simulith_context_acquire();
+    TEST_ASSERT_NOT_NULL(a);
+    TEST_ASSERT_EQUAL_PTR(a, b);
+
+    // Settings can only change before the context is created
+    TEST_ASSERT_EQUAL_INT(-1, simulith_context_configure(2, 0));
+
+    simulith_context_release();
+    simulith_context_release();
+
+    TEST_ASSERT_EQUAL_INT(-1, simulith_context_configure(-1, 0));
+    TEST_ASSERT_EQUAL_INT(0, simulith_context_configure(2, 0));
+    void *c = simulith_context_acquire();
+    TEST_ASSERT_NOT_NULL(c);
+    simulith_context_release();
+}
+
 int main(void)
 {
     UNITY_BEGIN();
     RUN_TEST(test_log_default_stdout);
     RUN_TEST(test_log_none);
     RUN_TEST(test_log_file_and_both);
+    RUN_TEST(test_tick_frame_decode);
+    RUN_TEST(test_histogram);
+    RUN_TEST(test_shared_context_refcount);
     return UNITY_END();
 }
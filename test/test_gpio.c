@@ -0,0 +1,111 @@
+#include "unity.h"
+#include <pthread.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "simulith.h"
+
+#define TEST_GPIO_NAME "/simulith_gpio_test"
+
+void setUp(void) { }
+void tearDown(void) { }
+
+static void test_gpio_shared_bank(void)
+{
+    TEST_ASSERT_NULL(simulith_gpio_open(TEST_GPIO_NAME));
+
+    simulith_gpio_bank_t* sim = simulith_gpio_create(TEST_GPIO_NAME, 64);
+    TEST_ASSERT_NOT_NULL(sim);
+    simulith_gpio_bank_t* fsw = simulith_gpio_open(TEST_GPIO_NAME);
+    TEST_ASSERT_NOT_NULL(fsw);
+    TEST_ASSERT_EQUAL_UINT(64, simulith_gpio_pin_count(fsw));
+
+    // Pins start as low inputs
+    simulith_gpio_state_t state;
+    TEST_ASSERT_EQUAL_INT(0, simulith_gpio_get_state(fsw, 63, &state));
+    TEST_ASSERT_EQUAL_INT(63, state.pin);
+    TEST_ASSERT_EQUAL_INT(0, state.direction);
+    TEST_ASSERT_EQUAL_INT(0, state.value);
+
+    // Both sides see each other's writes
+    TEST_ASSERT_EQUAL_INT(0, simulith_gpio_write(sim, 3, 1));
+    TEST_ASSERT_EQUAL_INT(1, simulith_gpio_read(fsw, 3));
+    TEST_ASSERT_EQUAL_INT(0, simulith_gpio_set_direction(fsw, 5, 1));
+    TEST_ASSERT_EQUAL_INT(0, simulith_gpio_write(fsw, 5, 7));
+    TEST_ASSERT_EQUAL_INT(0, simulith_gpio_get_state(sim, 5, &state));
+    TEST_ASSERT_EQUAL_INT(1, state.direction);
+    TEST_ASSERT_EQUAL_INT(1, state.value);
+
+    // Only level changes are edges
+    TEST_ASSERT_EQUAL_INT(0, simulith_gpio_write(sim, 3, 1));
+    TEST_ASSERT_EQUAL_UINT32(1, simulith_gpio_edges(fsw, 3));
+    TEST_ASSERT_EQUAL_INT(0, simulith_gpio_write(sim, 3, 0));
+    TEST_ASSERT_EQUAL_INT(0, simulith_gpio_write(sim, 3, 1));
+    TEST_ASSERT_EQUAL_UINT32(3, simulith_gpio_edges(fsw, 3));
+    TEST_ASSERT_EQUAL_UINT32(4, simulith_gpio_edge_seq(fsw));
+
+    // Closing the creator removes the name; mapped users keep the pins
+    simulith_gpio_close(sim);
+    TEST_ASSERT_NULL(simulith_gpio_open(TEST_GPIO_NAME));
+    TEST_ASSERT_EQUAL_INT(1, simulith_gpio_read(fsw, 3));
+    simulith_gpio_close(fsw);
+}
+
+static void test_gpio_invalid_params(void)
+{
+    TEST_ASSERT_NULL(simulith_gpio_create("no_leading_slash", 8));
+    TEST_ASSERT_NULL(simulith_gpio_create(NULL, 0));
+    TEST_ASSERT_NULL(simulith_gpio_open(NULL));
+
+    simulith_gpio_bank_t* bank = simulith_gpio_create(NULL, 8);
+    TEST_ASSERT_NOT_NULL(bank);
+    TEST_ASSERT_EQUAL_INT(-1, simulith_gpio_write(bank, 8, 1));
+    TEST_ASSERT_EQUAL_INT(-1, simulith_gpio_read(bank, 8));
+    TEST_ASSERT_EQUAL_INT(-1, simulith_gpio_set_direction(bank, 8, 1));
+    TEST_ASSERT_EQUAL_INT(-1, simulith_gpio_get_state(bank, 0, NULL));
+    TEST_ASSERT_EQUAL_INT(-1, simulith_gpio_wait_edge(bank, NULL, 0));
+    TEST_ASSERT_EQUAL_INT(-1, simulith_gpio_read(NULL, 0));
+    TEST_ASSERT_EQUAL_UINT(0, simulith_gpio_pin_count(NULL));
+    simulith_gpio_close(bank);
+    simulith_gpio_close(NULL);
+}
+
+static void* edge_thread(void* arg)
+{
+    usleep(20000);
+    simulith_gpio_write((simulith_gpio_bank_t*)arg, 2, 1);
+    return NULL;
+}
+
+// A waiter sleeps until another thread drives a pin
+static void test_gpio_wait_edge(void)
+{
+    simulith_gpio_bank_t* bank = simulith_gpio_create(NULL, 8);
+    TEST_ASSERT_NOT_NULL(bank);
+
+    uint32_t seq = simulith_gpio_edge_seq(bank);
+    TEST_ASSERT_EQUAL_INT(0, simulith_gpio_wait_edge(bank, &seq, 10));
+    TEST_ASSERT_EQUAL_UINT32(0, seq);
+
+    pthread_t thread;
+    pthread_create(&thread, NULL, edge_thread, bank);
+    TEST_ASSERT_EQUAL_INT(1, simulith_gpio_wait_edge(bank, &seq, 5000));
+    TEST_ASSERT_EQUAL_UINT32(1, seq);
+    TEST_ASSERT_EQUAL_INT(1, simulith_gpio_read(bank, 2));
+    pthread_join(thread, NULL);
+
+    // An edge before the wait is not missed
+    simulith_gpio_write(bank, 2, 0);
+    TEST_ASSERT_EQUAL_INT(1, simulith_gpio_wait_edge(bank, &seq, 0));
+    TEST_ASSERT_EQUAL_UINT32(2, seq);
+    simulith_gpio_close(bank);
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_gpio_shared_bank);
+    RUN_TEST(test_gpio_invalid_params);
+    RUN_TEST(test_gpio_wait_edge);
+    return UNITY_END();
+}
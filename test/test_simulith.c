@@ -6,6 +6,7 @@
 #include <sys/wait.h>
 #include <string.h>
 #include <stdlib.h>
+#include <time.h>
 #include <zmq.h>
 
 #define INVALID_ADDR "invalid://address"
@@ -273,6 +274,95 @@ static void test_server_ack_handling(void)
     pthread_join(server, NULL);
 }
 
+// An ASYNC client's ACK gets no reply; the next tick is the confirmation
+static void test_server_async_ack_no_reply(void)
+{
+    pthread_t server;
+    int i = 1;
+    pthread_create(&server, NULL, server_thread_with_clients, &i);
+    usleep(10000);
+
+    void *ctx = zmq_ctx_new();
+    void *sub = zmq_socket(ctx, ZMQ_SUB);
+    void *dealer = zmq_socket(ctx, ZMQ_DEALER);
+    int timeout_ms = 2000;
+    int linger = 0;
+    zmq_setsockopt(sub, ZMQ_SUBSCRIBE, "", 0);
+    zmq_setsockopt(sub, ZMQ_RCVTIMEO, &timeout_ms, sizeof(timeout_ms));
+    zmq_setsockopt(dealer, ZMQ_RCVTIMEO, &timeout_ms, sizeof(timeout_ms));
+    zmq_setsockopt(dealer, ZMQ_LINGER, &linger, sizeof(linger));
+    TEST_ASSERT_EQUAL_INT(0, zmq_connect(sub, LOCAL_PUB_ADDR));
+    TEST_ASSERT_EQUAL_INT(0, zmq_connect(dealer, LOCAL_REP_ADDR));
+    usleep(10000);
+
+    const char *ready = "READY ASYNCTEST ASYNC";
+    zmq_send(dealer, "", 0, ZMQ_SNDMORE);
+    zmq_send(dealer, ready, strlen(ready), 0);
+    char reply[16] = {0};
+    TEST_ASSERT_EQUAL_INT(0, zmq_recv(dealer, reply, sizeof(reply) - 1, 0)); // delimiter
+    TEST_ASSERT_EQUAL_INT(3, zmq_recv(dealer, reply, sizeof(reply) - 1, 0));
+    TEST_ASSERT_EQUAL_STRING("ACK", reply);
+
+    simulith_tick_frame_t frame;
+    TEST_ASSERT_EQUAL_INT(sizeof(frame), zmq_recv(sub, &frame, sizeof(frame), 0));
+    uint64_t first_ns = frame.time_ns;
+
+    zmq_send(dealer, "", 0, ZMQ_SNDMORE);
+    zmq_send(dealer, "ASYNCTEST", 9, 0);
+    do // The first tick may be re-published before the ACK arrives
+    {
+        TEST_ASSERT_EQUAL_INT(sizeof(frame), zmq_recv(sub, &frame, sizeof(frame), 0));
+    } while (frame.time_ns == first_ns);
+    TEST_ASSERT_EQUAL_UINT64(first_ns + INTERVAL_NS, frame.time_ns);
+
+    zmq_pollitem_t items[] = { { dealer, 0, ZMQ_POLLIN, 0 } };
+    TEST_ASSERT_EQUAL_INT(0, zmq_poll(items, 1, 50));
+
+    zmq_close(sub);
+    zmq_close(dealer);
+    zmq_ctx_term(ctx);
+    simulith_server_shutdown();
+    pthread_cancel(server);
+    pthread_join(server, NULL);
+}
+
+// Two client handles in one process and one thread should each take part in the barrier
+static void test_client_multiple_handles(void)
+{
+    pthread_t server;
+    int i = 2;
+    pthread_create(&server, NULL, server_thread_with_clients, &i);
+    usleep(10000);
+
+    simulith_client_t *a = simulith_client_create(LOCAL_PUB_ADDR, LOCAL_REP_ADDR, "handle_a", INTERVAL_NS);
+    simulith_client_t *b = simulith_client_create(LOCAL_PUB_ADDR, LOCAL_REP_ADDR, "handle_b", 2 * INTERVAL_NS);
+    TEST_ASSERT_NOT_NULL(a);
+    TEST_ASSERT_NOT_NULL(b);
+    TEST_ASSERT_EQUAL_INT(0, simulith_client_handshake_r(a));
+    TEST_ASSERT_EQUAL_INT(0, simulith_client_handshake_r(b));
+
+    for (int tick = 0; tick < 5; ++tick)
+    {
+        uint64_t a_ns = 0, b_ns = 0;
+        TEST_ASSERT_EQUAL_INT(0, simulith_client_wait_for_tick_r(a, &a_ns));
+        TEST_ASSERT_EQUAL_INT(0, simulith_client_wait_for_tick_r(b, &b_ns));
+        TEST_ASSERT_EQUAL_UINT64(a_ns, b_ns);
+    }
+
+    simulith_client_destroy(a);
+    simulith_client_destroy(b);
+    simulith_server_shutdown();
+    pthread_cancel(server);
+    pthread_join(server, NULL);
+}
+
+static void test_client_create_invalid_params(void)
+{
+    TEST_ASSERT_NULL(simulith_client_create(LOCAL_PUB_ADDR, LOCAL_REP_ADDR, NULL, INTERVAL_NS));
+    TEST_ASSERT_NULL(simulith_client_create(INVALID_ADDR, LOCAL_REP_ADDR, CLIENT_ID, INTERVAL_NS));
+    TEST_ASSERT_EQUAL_INT(-1, simulith_client_wait_for_tick_r(NULL, NULL));
+}
+
 // Test server CLI: send a sequence of commands via a pipe to stdin to trigger pause/play and speed changes
 static void test_server_cli_commands(void)
 {
@@ -351,6 +441,471 @@ static void test_server_handle_unknown_client_ack(void)
     unsetenv("SIMULITH_LOG_MODE");
 }
 
+// Pre-roll speed must be within the CLI speed limits
+static void test_server_preroll_invalid_speed(void)
+{
+    TEST_ASSERT_EQUAL_INT(-1, simulith_server_set_preroll(1000000000ULL, 0.0));
+    TEST_ASSERT_EQUAL_INT(-1, simulith_server_set_preroll(1000000000ULL, 4096.0));
+    TEST_ASSERT_EQUAL_INT(0, simulith_server_set_preroll(1000000000ULL, 1.0));
+    TEST_ASSERT_EQUAL_INT(0, simulith_server_set_preroll(0, 1.0));
+}
+
+static uint64_t test_monotonic_ms(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000ULL + (uint64_t)ts.tv_nsec / 1000000ULL;
+}
+
+#define PREROLL_UNTIL_NS 5000000000ULL // 5 s of sim time
+
+static void *server_thread_preroll(void *arg)
+{
+    simulith_server_init(LOCAL_PUB_ADDR, LOCAL_REP_ADDR, 1, INTERVAL_NS);
+    simulith_server_set_preroll(PREROLL_UNTIL_NS, 1.0);
+    simulith_server_run();
+    return NULL;
+}
+
+// Pre-roll should reach the target sim time far faster than real time, then drop back to paced ticks
+static void test_server_preroll_then_paced(void)
+{
+    pthread_t server;
+    pthread_create(&server, NULL, server_thread_preroll, NULL);
+    usleep(10000);
+
+    TEST_ASSERT_EQUAL_INT(0, simulith_client_init(LOCAL_PUB_ADDR, LOCAL_REP_ADDR, CLIENT_ID, INTERVAL_NS));
+    TEST_ASSERT_EQUAL_INT(0, simulith_client_handshake());
+
+    uint64_t tick_ns = 0;
+    uint64_t start_ms = test_monotonic_ms();
+    while (tick_ns < PREROLL_UNTIL_NS)
+    {
+        TEST_ASSERT_EQUAL_INT(0, simulith_client_wait_for_tick(&tick_ns));
+    }
+    uint64_t preroll_ms = test_monotonic_ms() - start_ms;
+    TEST_ASSERT_TRUE(preroll_ms < 2500); // 5 s of sim time at well over 2x
+
+    // Once past the target, 20 ticks of 10 ms should take roughly 200 ms of real time
+    start_ms = test_monotonic_ms();
+    for (int i = 0; i < 20; ++i)
+    {
+        TEST_ASSERT_EQUAL_INT(0, simulith_client_wait_for_tick(&tick_ns));
+    }
+    TEST_ASSERT_TRUE(test_monotonic_ms() - start_ms >= 100);
+
+    simulith_client_shutdown();
+    simulith_server_shutdown();
+    pthread_cancel(server);
+    pthread_join(server, NULL);
+}
+
+static void test_server_interval_limits_invalid(void)
+{
+    TEST_ASSERT_EQUAL_INT(-1, simulith_server_set_interval_limits(0, INTERVAL_NS));
+    TEST_ASSERT_EQUAL_INT(-1, simulith_server_set_interval_limits(2 * INTERVAL_NS, INTERVAL_NS));
+    TEST_ASSERT_EQUAL_INT(0, simulith_server_set_interval_limits(INTERVAL_NS, INTERVAL_NS));
+}
+
+static void *server_thread_variable_interval(void *arg)
+{
+    simulith_server_init(LOCAL_PUB_ADDR, LOCAL_REP_ADDR, 1, INTERVAL_NS);
+    simulith_server_set_interval_limits(INTERVAL_NS, 10 * INTERVAL_NS);
+    simulith_server_run();
+    return NULL;
+}
+
+// A client's requested max step should set the interval, bounded by the server limits
+static void test_client_requested_tick_interval(void)
+{
+    pthread_t server;
+    pthread_create(&server, NULL, server_thread_variable_interval, NULL);
+    usleep(10000);
+
+    TEST_ASSERT_EQUAL_INT(0, simulith_client_init(LOCAL_PUB_ADDR, LOCAL_REP_ADDR, CLIENT_ID, INTERVAL_NS));
+    TEST_ASSERT_EQUAL_INT(0, simulith_client_handshake());
+
+    uint64_t tick_ns = 0;
+    TEST_ASSERT_EQUAL_INT(0, simulith_client_wait_for_tick(&tick_ns));
+    TEST_ASSERT_EQUAL_UINT64(INTERVAL_NS, simulith_client_get_tick_interval());
+
+    // Request 5x the base interval; it applies from the step after the next tick
+    simulith_client_set_max_step(5 * INTERVAL_NS);
+    TEST_ASSERT_EQUAL_INT(0, simulith_client_wait_for_tick(&tick_ns));
+    TEST_ASSERT_EQUAL_INT(0, simulith_client_wait_for_tick(&tick_ns));
+    TEST_ASSERT_EQUAL_UINT64(5 * INTERVAL_NS, simulith_client_get_tick_interval());
+
+    uint64_t prev_ns = tick_ns;
+    TEST_ASSERT_EQUAL_INT(0, simulith_client_wait_for_tick(&tick_ns));
+    TEST_ASSERT_EQUAL_UINT64(5 * INTERVAL_NS, tick_ns - prev_ns);
+
+    // Requests above the configured maximum are clamped
+    simulith_client_set_max_step(100 * INTERVAL_NS);
+    TEST_ASSERT_EQUAL_INT(0, simulith_client_wait_for_tick(&tick_ns));
+    TEST_ASSERT_EQUAL_INT(0, simulith_client_wait_for_tick(&tick_ns));
+    TEST_ASSERT_EQUAL_UINT64(10 * INTERVAL_NS, simulith_client_get_tick_interval());
+
+    // Clearing the request returns to the server's base interval
+    simulith_client_set_max_step(0);
+    TEST_ASSERT_EQUAL_INT(0, simulith_client_wait_for_tick(&tick_ns));
+    TEST_ASSERT_EQUAL_INT(0, simulith_client_wait_for_tick(&tick_ns));
+    TEST_ASSERT_EQUAL_UINT64(INTERVAL_NS, simulith_client_get_tick_interval());
+
+    simulith_client_shutdown();
+    simulith_server_shutdown();
+    pthread_cancel(server);
+    pthread_join(server, NULL);
+}
+
+static void *server_thread_delayed(void *arg)
+{
+    usleep(100000); // Start after the client is already polling for us
+    return server_thread_with_clients(arg);
+}
+
+// A client started before the server should connect as soon as the server is up
+static void test_client_handshake_before_server(void)
+{
+    pthread_t server;
+    int i = 1;
+
+    simulith_client_t *client = simulith_client_create(LOCAL_PUB_ADDR, LOCAL_REP_ADDR, "early_client", INTERVAL_NS);
+    TEST_ASSERT_NOT_NULL(client);
+    simulith_client_set_handshake_timeout_r(client, 5000);
+
+    pthread_create(&server, NULL, server_thread_delayed, &i);
+    uint64_t start_ms = test_monotonic_ms();
+    TEST_ASSERT_EQUAL_INT(0, simulith_client_handshake_r(client));
+    TEST_ASSERT_LESS_THAN_UINT64(1000, test_monotonic_ms() - start_ms);
+
+    uint64_t first_ns = 0, next_ns = 0;
+    TEST_ASSERT_EQUAL_INT(0, simulith_client_wait_for_tick_r(client, &first_ns));
+    TEST_ASSERT_EQUAL_INT(0, simulith_client_wait_for_tick_r(client, &next_ns));
+    TEST_ASSERT_EQUAL_UINT64(first_ns + INTERVAL_NS, next_ns);
+
+    simulith_client_destroy(client);
+    simulith_server_shutdown();
+    pthread_cancel(server);
+    pthread_join(server, NULL);
+}
+
+// Retrying READY on the same connection is acknowledged again instead of rejected
+static void test_server_repeated_ready(void)
+{
+    pthread_t server;
+    int i = 2;
+    pthread_create(&server, NULL, server_thread_with_clients, &i);
+    usleep(10000);
+
+    void *ctx = zmq_ctx_new();
+    void *dealer = zmq_socket(ctx, ZMQ_DEALER);
+    int timeout_ms = 2000;
+    int linger = 0;
+    zmq_setsockopt(dealer, ZMQ_RCVTIMEO, &timeout_ms, sizeof(timeout_ms));
+    zmq_setsockopt(dealer, ZMQ_LINGER, &linger, sizeof(linger));
+    TEST_ASSERT_EQUAL_INT(0, zmq_connect(dealer, LOCAL_REP_ADDR));
+
+    const char *ready = "READY RETRYTEST ASYNC";
+    for (int attempt = 0; attempt < 2; ++attempt)
+    {
+        char reply[16] = {0};
+        zmq_send(dealer, "", 0, ZMQ_SNDMORE);
+        zmq_send(dealer, ready, strlen(ready), 0);
+        TEST_ASSERT_EQUAL_INT(0, zmq_recv(dealer, reply, sizeof(reply) - 1, 0)); // delimiter
+        TEST_ASSERT_EQUAL_INT(3, zmq_recv(dealer, reply, sizeof(reply) - 1, 0));
+        TEST_ASSERT_EQUAL_STRING("ACK", reply);
+    }
+
+    // The same id from a different connection is still a duplicate
+    char reply[32] = {0};
+    TEST_ASSERT_EQUAL_INT(0, zmq_req_send_and_recv(LOCAL_REP_ADDR, "READY RETRYTEST", reply, sizeof(reply)));
+    TEST_ASSERT_EQUAL_STRING("DUP_ID", reply);
+
+    zmq_close(dealer);
+    zmq_ctx_term(ctx);
+    simulith_server_shutdown();
+    pthread_cancel(server);
+    pthread_join(server, NULL);
+}
+
+// A READY retry that lands once ticking has started gets no second reply
+static void test_server_late_ready_ignored(void)
+{
+    pthread_t server;
+    int i = 1;
+    pthread_create(&server, NULL, server_thread_with_clients, &i);
+    usleep(10000);
+
+    void *ctx = zmq_ctx_new();
+    void *dealer = zmq_socket(ctx, ZMQ_DEALER);
+    int timeout_ms = 2000;
+    int linger = 0;
+    zmq_setsockopt(dealer, ZMQ_RCVTIMEO, &timeout_ms, sizeof(timeout_ms));
+    zmq_setsockopt(dealer, ZMQ_LINGER, &linger, sizeof(linger));
+    TEST_ASSERT_EQUAL_INT(0, zmq_connect(dealer, LOCAL_REP_ADDR));
+
+    const char *ready = "READY LATERETRY ASYNC";
+    char reply[16] = {0};
+    zmq_send(dealer, "", 0, ZMQ_SNDMORE);
+    zmq_send(dealer, ready, strlen(ready), 0);
+    TEST_ASSERT_EQUAL_INT(0, zmq_recv(dealer, reply, sizeof(reply) - 1, 0)); // delimiter
+    TEST_ASSERT_EQUAL_INT(3, zmq_recv(dealer, reply, sizeof(reply) - 1, 0));
+    TEST_ASSERT_EQUAL_STRING("ACK", reply);
+
+    // The server is now waiting for this client's tick ACK
+    usleep(10000);
+    zmq_send(dealer, "", 0, ZMQ_SNDMORE);
+    zmq_send(dealer, ready, strlen(ready), 0);
+    zmq_send(dealer, "", 0, ZMQ_SNDMORE);
+    zmq_send(dealer, "LATERETRY", strlen("LATERETRY"), 0);
+
+    zmq_pollitem_t items[] = { { dealer, 0, ZMQ_POLLIN, 0 } };
+    TEST_ASSERT_EQUAL_INT(0, zmq_poll(items, 1, 200));
+
+    zmq_close(dealer);
+    zmq_ctx_term(ctx);
+    simulith_server_shutdown();
+    pthread_cancel(server);
+    pthread_join(server, NULL);
+}
+
+// Minimal stand-in server: acknowledge the next READY on the router socket
+static void *ack_ready_thread(void *arg)
+{
+    void *router = arg;
+    char  id[256];
+    char  msg[96];
+    for (;;)
+    {
+        int id_len = zmq_recv(router, id, sizeof(id), 0);
+        if (id_len < 0)
+        {
+            return NULL;
+        }
+        zmq_recv(router, msg, sizeof(msg), 0); // delimiter
+        int len = zmq_recv(router, msg, sizeof(msg) - 1, 0);
+        if (len >= 5 && strncmp(msg, "READY", 5) == 0) // Skip tick ACKs left over from the last run
+        {
+            zmq_send(router, id, id_len, ZMQ_SNDMORE);
+            zmq_send(router, "", 0, ZMQ_SNDMORE);
+            zmq_send(router, "ACK", 3, 0);
+            return NULL;
+        }
+    }
+}
+
+// A client that handshakes again with a restarted server accepts its ticks from zero
+static void test_client_rehandshake_after_server_restart(void)
+{
+    simulith_client_t *client = simulith_client_create(LOCAL_PUB_ADDR, LOCAL_REP_ADDR, "restart_client", INTERVAL_NS);
+    TEST_ASSERT_NOT_NULL(client);
+
+    for (int run = 0; run < 2; ++run)
+    {
+        void *ctx    = zmq_ctx_new();
+        void *pub    = zmq_socket(ctx, ZMQ_PUB);
+        void *router = zmq_socket(ctx, ZMQ_ROUTER);
+        int   timeout_ms = 2000;
+        int   linger     = 0;
+        zmq_setsockopt(router, ZMQ_RCVTIMEO, &timeout_ms, sizeof(timeout_ms));
+        zmq_setsockopt(router, ZMQ_LINGER, &linger, sizeof(linger));
+        zmq_setsockopt(pub, ZMQ_LINGER, &linger, sizeof(linger));
+        TEST_ASSERT_EQUAL_INT(0, zmq_bind(pub, LOCAL_PUB_ADDR));
+        TEST_ASSERT_EQUAL_INT(0, zmq_bind(router, LOCAL_REP_ADDR));
+
+        pthread_t server;
+        pthread_create(&server, NULL, ack_ready_thread, router);
+        TEST_ASSERT_EQUAL_INT(0, simulith_client_handshake_r(client));
+        pthread_join(server, NULL);
+
+        // Each run of the server starts its clock from zero. Like the real server,
+        // repeat the first tick until the subscriber has (re)connected.
+        simulith_tick_frame_t frame   = { INTERVAL_NS, INTERVAL_NS, 1.0 };
+        uint64_t              tick_ns = 0;
+        int                   rc      = 1;
+        for (int attempt = 0; rc == 1 && attempt < 100; ++attempt)
+        {
+            zmq_send(pub, &frame, sizeof(frame), 0);
+            rc = simulith_client_wait_for_tick_timeout_r(client, &tick_ns, 20);
+        }
+        TEST_ASSERT_EQUAL_INT(0, rc);
+        TEST_ASSERT_EQUAL_UINT64(INTERVAL_NS, tick_ns);
+
+        for (uint64_t tick = 2; tick <= 3; ++tick)
+        {
+            frame.time_ns = tick * INTERVAL_NS;
+            TEST_ASSERT_EQUAL_INT(sizeof(frame), zmq_send(pub, &frame, sizeof(frame), 0));
+            TEST_ASSERT_EQUAL_INT(0, simulith_client_wait_for_tick_timeout_r(client, &tick_ns, 1000));
+            TEST_ASSERT_EQUAL_UINT64(tick * INTERVAL_NS, tick_ns);
+        }
+
+        zmq_close(pub);
+        zmq_close(router);
+        zmq_ctx_term(ctx);
+    }
+
+    simulith_client_destroy(client);
+    TEST_ASSERT_EQUAL_INT(-1, simulith_client_handshake_r(NULL));
+}
+
+// Observers see ticks without being waited on by the server
+static void test_client_observer(void)
+{
+    pthread_t server;
+    int i = 1;
+    pthread_create(&server, NULL, server_thread_with_clients, &i);
+    usleep(10000);
+
+    simulith_client_t *observer = simulith_client_create_observer(LOCAL_PUB_ADDR, "observer");
+    simulith_client_t *client = simulith_client_create(LOCAL_PUB_ADDR, LOCAL_REP_ADDR, "observed", INTERVAL_NS);
+    TEST_ASSERT_NOT_NULL(observer);
+    TEST_ASSERT_NOT_NULL(client);
+    TEST_ASSERT_EQUAL_INT(0, simulith_client_handshake_r(observer));
+    TEST_ASSERT_EQUAL_INT(0, simulith_client_handshake_r(client));
+
+    // The single expected client drives time on its own while the observer lags
+    uint64_t client_ns = 0;
+    for (int tick = 0; tick < 10; ++tick)
+    {
+        TEST_ASSERT_EQUAL_INT(0, simulith_client_wait_for_tick_r(client, &client_ns));
+    }
+
+    // A lagging observer skips straight to the latest tick
+    uint64_t observer_ns = 0;
+    TEST_ASSERT_EQUAL_INT(0, simulith_client_wait_for_tick_r(observer, &observer_ns));
+    TEST_ASSERT_GREATER_OR_EQUAL_UINT64(client_ns, observer_ns);
+
+    simulith_client_destroy(observer);
+    simulith_client_destroy(client);
+    simulith_server_shutdown();
+    pthread_cancel(server);
+    pthread_join(server, NULL);
+
+    TEST_ASSERT_NULL(simulith_client_create_observer(NULL, "observer"));
+    TEST_ASSERT_NULL(simulith_client_create_observer(LOCAL_PUB_ADDR, ""));
+}
+
+static int run_loop_result = -2;
+
+static void *run_loop_thread(void *arg)
+{
+    run_loop_result = simulith_client_run_loop_r((simulith_client_t *)arg, on_tick);
+    return NULL;
+}
+
+// Ticks can be taken from a caller's own event loop, and the run loop can be stopped
+static void test_client_event_loop_integration(void)
+{
+    simulith_client_t *client = simulith_client_create(LOCAL_PUB_ADDR, LOCAL_REP_ADDR, "evloop", INTERVAL_NS);
+    TEST_ASSERT_NOT_NULL(client);
+
+    // Nothing is published yet
+    uint64_t tick_ns = 0;
+    int fd = -1;
+    TEST_ASSERT_EQUAL_INT(0, simulith_client_get_fd_r(client, &fd));
+    TEST_ASSERT_TRUE(fd >= 0);
+    TEST_ASSERT_EQUAL_INT(1, simulith_client_try_tick_r(client, &tick_ns));
+    TEST_ASSERT_EQUAL_INT(1, simulith_client_wait_for_tick_timeout_r(client, &tick_ns, 20));
+
+    pthread_t server;
+    int i = 1;
+    pthread_create(&server, NULL, server_thread_with_clients, &i);
+    TEST_ASSERT_EQUAL_INT(0, simulith_client_handshake_r(client));
+
+    uint64_t first_ns = 0;
+    TEST_ASSERT_EQUAL_INT(0, simulith_client_wait_for_tick_timeout_r(client, &first_ns, 1000));
+    TEST_ASSERT_EQUAL_INT(0, simulith_client_wait_for_tick_timeout_r(client, &tick_ns, 1000));
+    TEST_ASSERT_EQUAL_UINT64(first_ns + INTERVAL_NS, tick_ns);
+
+    // The run loop keeps ticking until asked to stop
+    pthread_t loop;
+    pthread_create(&loop, NULL, run_loop_thread, client);
+    usleep(200000);
+    simulith_client_stop_r(client);
+    pthread_join(loop, NULL);
+    TEST_ASSERT_GREATER_THAN(0, ticks_received);
+    TEST_ASSERT_EQUAL_INT(0, run_loop_result);
+
+    simulith_client_destroy(client);
+    simulith_server_shutdown();
+    pthread_cancel(server);
+    pthread_join(server, NULL);
+
+    TEST_ASSERT_EQUAL_INT(-1, simulith_client_get_fd_r(NULL, &fd));
+    TEST_ASSERT_EQUAL_INT(-1, simulith_client_try_tick_r(NULL, &tick_ns));
+    TEST_ASSERT_EQUAL_INT(-1, simulith_client_run_loop_r(NULL, on_tick));
+}
+
+// Time between wait_for_tick calls counts as callback time, time blocked as wait
+static void test_client_timing_stats(void)
+{
+    pthread_t server;
+    int i = 1;
+    pthread_create(&server, NULL, server_thread_with_clients, &i);
+
+    simulith_client_t *client = simulith_client_create(LOCAL_PUB_ADDR, LOCAL_REP_ADDR, "timed", INTERVAL_NS);
+    TEST_ASSERT_NOT_NULL(client);
+    simulith_client_set_stats_report_r(client, 1);
+    TEST_ASSERT_EQUAL_INT(0, simulith_client_handshake_r(client));
+
+    uint64_t first_ns = 0, tick_ns = 0;
+    TEST_ASSERT_EQUAL_INT(0, simulith_client_wait_for_tick_r(client, &first_ns));
+    for (int tick = 0; tick < 5; ++tick)
+    {
+        usleep(2000); // "Compute"
+        TEST_ASSERT_EQUAL_INT(0, simulith_client_wait_for_tick_r(client, &tick_ns));
+    }
+    // Reported timing in the ACKs does not disturb the barrier
+    TEST_ASSERT_EQUAL_UINT64(first_ns + 5 * INTERVAL_NS, tick_ns);
+
+    simulith_client_stats_t stats;
+    TEST_ASSERT_EQUAL_INT(0, simulith_client_get_stats_r(client, &stats));
+    TEST_ASSERT_EQUAL_UINT64(6, stats.wait.count);
+    TEST_ASSERT_EQUAL_UINT64(5, stats.callback.count);
+    TEST_ASSERT_EQUAL_UINT64(6, stats.ack.count);
+    TEST_ASSERT_TRUE(stats.callback.total_ns >= 5 * 2000000ULL);
+
+    simulith_client_reset_stats_r(client);
+    TEST_ASSERT_EQUAL_INT(0, simulith_client_get_stats_r(client, &stats));
+    TEST_ASSERT_EQUAL_UINT64(0, stats.wait.count);
+    TEST_ASSERT_EQUAL_INT(-1, simulith_client_get_stats_r(NULL, &stats));
+
+    simulith_client_destroy(client);
+    simulith_server_shutdown();
+    pthread_cancel(server);
+    pthread_join(server, NULL);
+}
+
+// Ticks received by a client are visible to any reader of its shared clock
+static void test_client_publishes_shared_clock(void)
+{
+    pthread_t server;
+    int i = 1;
+    pthread_create(&server, NULL, server_thread_with_clients, &i);
+
+    simulith_client_t *client = simulith_client_create(LOCAL_PUB_ADDR, LOCAL_REP_ADDR, "clocked", INTERVAL_NS);
+    TEST_ASSERT_NOT_NULL(client);
+    TEST_ASSERT_EQUAL_INT(0, simulith_client_publish_clock_r(client, "/simulith_clock_client_test"));
+    simulith_clock_t *reader = simulith_clock_open("/simulith_clock_client_test");
+    TEST_ASSERT_NOT_NULL(reader);
+    TEST_ASSERT_EQUAL_INT(0, simulith_client_handshake_r(client));
+
+    uint64_t tick_ns = 0, seq = 0;
+    for (int tick = 0; tick < 3; ++tick)
+    {
+        TEST_ASSERT_EQUAL_INT(0, simulith_client_wait_for_tick_r(client, &tick_ns));
+    }
+    TEST_ASSERT_EQUAL_UINT64(tick_ns, simulith_clock_now_ns(reader));
+    TEST_ASSERT_EQUAL_INT(0, simulith_clock_read(reader, NULL, NULL, &seq));
+    TEST_ASSERT_EQUAL_UINT64(3, seq);
+
+    simulith_clock_close(reader);
+    simulith_client_destroy(client);
+    simulith_server_shutdown();
+    pthread_cancel(server);
+    pthread_join(server, NULL);
+}
+
 int main(void)
 {
     UNITY_BEGIN();
@@ -366,9 +921,24 @@ int main(void)
     RUN_TEST(test_server_handshake_invalid_format);
     RUN_TEST(test_server_handshake_duplicate_client_id);
     RUN_TEST(test_server_ack_handling);
+    RUN_TEST(test_server_async_ack_no_reply);
+    RUN_TEST(test_client_multiple_handles);
+    RUN_TEST(test_client_create_invalid_params);
     RUN_TEST(test_server_cli_commands);
     RUN_TEST(test_server_standalone_invalid_arg);
     RUN_TEST(test_server_handle_unknown_client_ack);
+    RUN_TEST(test_server_preroll_invalid_speed);
+    RUN_TEST(test_server_preroll_then_paced);
+    RUN_TEST(test_server_interval_limits_invalid);
+    RUN_TEST(test_client_requested_tick_interval);
+    RUN_TEST(test_client_handshake_before_server);
+    RUN_TEST(test_server_repeated_ready);
+    RUN_TEST(test_server_late_ready_ignored);
+    RUN_TEST(test_client_rehandshake_after_server_restart);
+    RUN_TEST(test_client_observer);
+    RUN_TEST(test_client_event_loop_integration);
+    RUN_TEST(test_client_timing_stats);
+    RUN_TEST(test_client_publishes_shared_clock);
 
     return UNITY_END();
 }
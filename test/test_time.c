@@ -1,4 +1,5 @@
 #include "unity.h"
+#include <pthread.h>
 #include <zmq.h>
 #include <unistd.h>
 #include <stdint.h>
@@ -47,9 +48,296 @@ static void test_time_init_get_wait_cleanup(void)
     zmq_ctx_destroy(ctx);
 }
 
+static void test_time_reports_tick_sim_time(void)
+{
+    const char* addr = "tcp://127.0.0.1:50010";
+    void* ctx = zmq_ctx_new();
+    void* pub = zmq_socket(ctx, ZMQ_PUB);
+    TEST_ASSERT_EQUAL_INT(0, zmq_bind(pub, addr));
+
+    void* handle = simulith_time_init_addr(addr);
+    TEST_ASSERT_NOT_NULL(handle);
+    usleep(10000);
+
+    // The provider reports the tick's sim time, not tick count times INTERVAL_NS
+    simulith_tick_frame_t frame = { 5000000000ULL, 250000000ULL };
+    TEST_ASSERT_EQUAL_INT(sizeof(frame), zmq_send(pub, &frame, sizeof(frame), 0));
+    TEST_ASSERT_EQUAL_INT(0, simulith_time_wait_for_next_tick(handle));
+    TEST_ASSERT_EQUAL_FLOAT(5.0f, (float)simulith_time_get(handle));
+
+    // A zero speed holds interpolated time at the tick
+    TEST_ASSERT_EQUAL_FLOAT(5.0f, (float)simulith_time_get_interpolated(handle));
+
+    // At real-time speed it moves on between ticks but never past the next one
+    frame.time_ns += frame.interval_ns;
+    frame.speed = 1.0;
+    TEST_ASSERT_EQUAL_INT(sizeof(frame), zmq_send(pub, &frame, sizeof(frame), 0));
+    TEST_ASSERT_EQUAL_INT(0, simulith_time_wait_for_next_tick(handle));
+    usleep(10000);
+    double now = simulith_time_get_interpolated(handle);
+    TEST_ASSERT_TRUE(now > 5.25);
+    TEST_ASSERT_TRUE(now <= 5.5);
+
+    simulith_time_cleanup(handle);
+    TEST_ASSERT_NULL(simulith_time_init_addr(NULL));
+
+    zmq_close(pub);
+    zmq_ctx_destroy(ctx);
+}
+
+typedef struct
+{
+    void*        handle;
+    int          ticks;
+    volatile int woken;
+} tick_waiter_t;
+
+static void* tick_waiter_thread(void* arg)
+{
+    tick_waiter_t* w = (tick_waiter_t*)arg;
+    for (int i = 0; i < w->ticks; ++i)
+    {
+        if (simulith_time_wait_for_next_tick(w->handle) != 0)
+            break;
+        w->woken++;
+    }
+    return NULL;
+}
+
+// Providers on one address share a subscription; each wakes at its own divisor
+static void test_time_shared_source_divisors(void)
+{
+    const char* addr = "tcp://127.0.0.1:50012";
+    void* ctx = zmq_ctx_new();
+    void* pub = zmq_socket(ctx, ZMQ_PUB);
+    TEST_ASSERT_EQUAL_INT(0, zmq_bind(pub, addr));
+
+    void* fast = simulith_time_init_addr(addr);
+    void* slow = simulith_time_init_addr(addr);
+    TEST_ASSERT_NOT_NULL(fast);
+    TEST_ASSERT_NOT_NULL(slow);
+    TEST_ASSERT_EQUAL_INT(-1, simulith_time_set_divisor(slow, 0));
+    TEST_ASSERT_EQUAL_INT(0, simulith_time_set_divisor(slow, 2));
+    usleep(10000);
+
+    tick_waiter_t fast_w = { fast, 2, 0 };
+    tick_waiter_t slow_w = { slow, 1, 0 };
+    pthread_t fast_t, slow_t;
+    pthread_create(&fast_t, NULL, tick_waiter_thread, &fast_w);
+    pthread_create(&slow_t, NULL, tick_waiter_thread, &slow_w);
+    usleep(10000);
+
+    simulith_tick_frame_t frame = { INTERVAL_NS, INTERVAL_NS, 1.0 };
+    TEST_ASSERT_EQUAL_INT(sizeof(frame), zmq_send(pub, &frame, sizeof(frame), 0));
+    usleep(50000);
+    TEST_ASSERT_EQUAL_INT(1, fast_w.woken);
+    TEST_ASSERT_EQUAL_INT(0, slow_w.woken);
+
+    frame.time_ns += INTERVAL_NS;
+    TEST_ASSERT_EQUAL_INT(sizeof(frame), zmq_send(pub, &frame, sizeof(frame), 0));
+    pthread_join(fast_t, NULL);
+    pthread_join(slow_t, NULL);
+    TEST_ASSERT_EQUAL_INT(2, fast_w.woken);
+    TEST_ASSERT_EQUAL_INT(1, slow_w.woken);
+
+    // Both handles see the one subscription's time
+    TEST_ASSERT_EQUAL_FLOAT(2 * INTERVAL_NS / 1e9f, (float)simulith_time_get(fast));
+    TEST_ASSERT_EQUAL_FLOAT(2 * INTERVAL_NS / 1e9f, (float)simulith_time_get(slow));
+
+    // The source outlives the first handle released
+    simulith_time_cleanup(fast);
+    frame.time_ns += INTERVAL_NS;
+    usleep(10000);
+    TEST_ASSERT_EQUAL_INT(sizeof(frame), zmq_send(pub, &frame, sizeof(frame), 0));
+    TEST_ASSERT_EQUAL_INT(0, simulith_time_set_divisor(slow, 1));
+    TEST_ASSERT_EQUAL_INT(0, simulith_time_wait_for_next_tick(slow));
+    TEST_ASSERT_EQUAL_FLOAT(3 * INTERVAL_NS / 1e9f, (float)simulith_time_get(slow));
+    simulith_time_cleanup(slow);
+
+    zmq_close(pub);
+    zmq_ctx_destroy(ctx);
+}
+
+typedef struct
+{
+    void*        handle;
+    uint64_t     deadline_ns;
+    volatile int woke;
+} sleeper_t;
+
+static void* sleeper_thread(void* arg)
+{
+    sleeper_t* s = (sleeper_t*)arg;
+    if (simulith_time_sleep_until(s->handle, s->deadline_ns) == 0)
+        s->woke = 1;
+    return NULL;
+}
+
+static void count_fire(void* arg, uint64_t now_ns)
+{
+    (*(int*)arg)++;
+}
+
+// Sleepers wake only once their deadline has passed; periodic timers fire every period
+static void test_time_sleep_until_and_timers(void)
+{
+    const char* addr = "tcp://127.0.0.1:50011";
+    void* ctx = zmq_ctx_new();
+    void* pub = zmq_socket(ctx, ZMQ_PUB);
+    TEST_ASSERT_EQUAL_INT(0, zmq_bind(pub, addr));
+
+    void* handle = simulith_time_init_addr(addr);
+    TEST_ASSERT_NOT_NULL(handle);
+    usleep(10000);
+
+    int periodic_fires = 0;
+    simulith_timer_t periodic;
+    simulith_timer_init(&periodic, count_fire, &periodic_fires);
+    TEST_ASSERT_EQUAL_INT(0, simulith_time_timer_start(handle, &periodic, 20000000ULL, 20000000ULL));
+
+    sleeper_t early = { handle, 30000000ULL, 0 };
+    sleeper_t late  = { handle, 50000000ULL, 0 };
+    pthread_t t_early, t_late;
+    pthread_create(&t_early, NULL, sleeper_thread, &early);
+    pthread_create(&t_late, NULL, sleeper_thread, &late);
+    usleep(10000);
+
+    for (uint64_t ms = 10; ms <= 40; ms += 10)
+    {
+        simulith_tick_frame_t frame = { ms * 1000000ULL, 10000000ULL };
+        zmq_send(pub, &frame, sizeof(frame), 0);
+        usleep(20000);
+    }
+    TEST_ASSERT_EQUAL_INT(1, early.woke);
+    TEST_ASSERT_EQUAL_INT(0, late.woke);
+    TEST_ASSERT_EQUAL_INT(2, periodic_fires); // 20 ms and 40 ms
+
+    simulith_tick_frame_t frame = { 50000000ULL, 10000000ULL };
+    zmq_send(pub, &frame, sizeof(frame), 0);
+    pthread_join(t_early, NULL);
+    pthread_join(t_late, NULL);
+    TEST_ASSERT_EQUAL_INT(1, late.woke);
+
+    // Deadlines already reached return at once
+    TEST_ASSERT_EQUAL_INT(0, simulith_time_sleep_until(handle, 10000000ULL));
+    TEST_ASSERT_EQUAL_INT(-1, simulith_time_sleep_until(NULL, 0));
+
+    simulith_time_timer_cancel(handle, &periodic);
+    simulith_time_cleanup(handle);
+    zmq_close(pub);
+    zmq_ctx_destroy(ctx);
+}
+
+// Timers fire as ticks arrive even when no thread is waiting on the provider
+static void test_time_timers_fire_without_waiter(void)
+{
+    const char* addr = "tcp://127.0.0.1:50013";
+    void* ctx = zmq_ctx_new();
+    void* pub = zmq_socket(ctx, ZMQ_PUB);
+    TEST_ASSERT_EQUAL_INT(0, zmq_bind(pub, addr));
+
+    void* handle = simulith_time_init_addr(addr);
+    TEST_ASSERT_NOT_NULL(handle);
+
+    int one_shot_fires = 0;
+    int periodic_fires = 0;
+    simulith_timer_t one_shot, periodic;
+    simulith_timer_init(&one_shot, count_fire, &one_shot_fires);
+    simulith_timer_init(&periodic, count_fire, &periodic_fires);
+    TEST_ASSERT_EQUAL_INT(0, simulith_time_timer_start(handle, &one_shot, 30000000ULL, 0));
+    TEST_ASSERT_EQUAL_INT(0, simulith_time_timer_start(handle, &periodic, 10000000ULL, 10000000ULL));
+    usleep(10000);
+
+    for (uint64_t ms = 10; ms <= 40; ms += 10)
+    {
+        simulith_tick_frame_t frame = { ms * 1000000ULL, 10000000ULL };
+        zmq_send(pub, &frame, sizeof(frame), 0);
+        usleep(20000);
+    }
+    TEST_ASSERT_EQUAL_INT(1, one_shot_fires);
+    TEST_ASSERT_EQUAL_INT(4, periodic_fires);
+    TEST_ASSERT_EQUAL_FLOAT(0.04f, (float)simulith_time_get(handle));
+
+    // A thread waiting alongside the provider's own receiver still gets its tick
+    simulith_tick_frame_t frame = { 50000000ULL, 10000000ULL };
+    tick_waiter_t w = { handle, 1, 0 };
+    pthread_t t;
+    pthread_create(&t, NULL, tick_waiter_thread, &w);
+    usleep(10000);
+    zmq_send(pub, &frame, sizeof(frame), 0);
+    pthread_join(t, NULL);
+    TEST_ASSERT_EQUAL_INT(1, w.woken);
+    TEST_ASSERT_EQUAL_INT(5, periodic_fires);
+
+    // Cleanup stops the receiving thread
+    simulith_time_timer_cancel(handle, &periodic);
+    simulith_time_cleanup(handle);
+    zmq_close(pub);
+    zmq_ctx_destroy(ctx);
+}
+
+typedef struct
+{
+    void*            handle;
+    simulith_timer_t timer;
+    volatile int     fires;
+} rearming_timer_t;
+
+static void rearm_fire(void* arg, uint64_t now_ns)
+{
+    rearming_timer_t* r = (rearming_timer_t*)arg;
+    if (++r->fires < 3)
+        simulith_time_timer_start(r->handle, &r->timer, now_ns + 10000000ULL, 0);
+}
+
+// A callback may re-arm itself through the provider while ticks are being received
+static void test_time_timer_rearms_from_callback(void)
+{
+    const char* addr = "tcp://127.0.0.1:50014";
+    void* ctx = zmq_ctx_new();
+    void* pub = zmq_socket(ctx, ZMQ_PUB);
+    TEST_ASSERT_EQUAL_INT(0, zmq_bind(pub, addr));
+
+    void* handle = simulith_time_init_addr(addr);
+    TEST_ASSERT_NOT_NULL(handle);
+
+    rearming_timer_t r = { handle };
+    simulith_timer_init(&r.timer, rearm_fire, &r);
+    TEST_ASSERT_EQUAL_INT(0, simulith_time_timer_start(handle, &r.timer, 10000000ULL, 0));
+    usleep(10000);
+
+    for (uint64_t ms = 10; ms <= 50; ms += 10)
+    {
+        simulith_tick_frame_t frame = { ms * 1000000ULL, 10000000ULL };
+        zmq_send(pub, &frame, sizeof(frame), 0);
+        usleep(20000);
+    }
+    TEST_ASSERT_EQUAL_INT(3, r.fires);
+    TEST_ASSERT_EQUAL_FLOAT(0.05f, (float)simulith_time_get(handle));
+
+    // The provider still serves waiting threads afterwards
+    tick_waiter_t w = { handle, 1, 0 };
+    pthread_t t;
+    pthread_create(&t, NULL, tick_waiter_thread, &w);
+    usleep(10000);
+    simulith_tick_frame_t frame = { 60000000ULL, 10000000ULL };
+    zmq_send(pub, &frame, sizeof(frame), 0);
+    pthread_join(t, NULL);
+    TEST_ASSERT_EQUAL_INT(1, w.woken);
+
+    simulith_time_cleanup(handle);
+    zmq_close(pub);
+    zmq_ctx_destroy(ctx);
+}
+
 int main(void)
 {
     UNITY_BEGIN();
     RUN_TEST(test_time_init_get_wait_cleanup);
+    RUN_TEST(test_time_reports_tick_sim_time);
+    RUN_TEST(test_time_sleep_until_and_timers);
+    RUN_TEST(test_time_shared_source_divisors);
+    RUN_TEST(test_time_timers_fire_without_waiter);
+    RUN_TEST(test_time_timer_rearms_from_callback);
     return UNITY_END();
 }
@@ -0,0 +1,152 @@
+#include "unity.h"
+#include <stdint.h>
+#include <string.h>
+
+#include "simulith.h"
+
+#define RES_NS 1000000ULL // 1 ms wheel resolution
+
+static simulith_timer_wheel_t* wheel;
+
+typedef struct
+{
+    int      fired;
+    uint64_t last_now_ns;
+} fire_log_t;
+
+void setUp(void)
+{
+    wheel = simulith_timer_wheel_create(RES_NS);
+}
+
+void tearDown(void)
+{
+    simulith_timer_wheel_destroy(wheel);
+}
+
+static void on_fire(void* arg, uint64_t now_ns)
+{
+    fire_log_t* log = (fire_log_t*)arg;
+    log->fired++;
+    log->last_now_ns = now_ns;
+}
+
+static void test_timer_one_shot_never_early(void)
+{
+    fire_log_t       log = {0};
+    simulith_timer_t timer;
+    simulith_timer_init(&timer, on_fire, &log);
+
+    TEST_ASSERT_EQUAL_INT(0, simulith_timer_start(wheel, &timer, 25500000ULL, 0)); // 25.5 ms
+    TEST_ASSERT_TRUE(simulith_timer_is_armed(&timer));
+
+    TEST_ASSERT_EQUAL_INT(0, simulith_timer_wheel_advance(wheel, 20000000ULL));
+    TEST_ASSERT_EQUAL_INT(0, simulith_timer_wheel_advance(wheel, 25000000ULL));
+    TEST_ASSERT_EQUAL_INT(1, simulith_timer_wheel_advance(wheel, 30000000ULL));
+    TEST_ASSERT_EQUAL_INT(1, log.fired);
+    TEST_ASSERT_EQUAL_UINT64(30000000ULL, log.last_now_ns);
+    TEST_ASSERT_FALSE(simulith_timer_is_armed(&timer));
+
+    TEST_ASSERT_EQUAL_INT(0, simulith_timer_wheel_advance(wheel, 40000000ULL));
+    TEST_ASSERT_EQUAL_INT(1, log.fired);
+}
+
+static void test_timer_periodic_and_cancel(void)
+{
+    fire_log_t       log = {0};
+    simulith_timer_t timer;
+    simulith_timer_init(&timer, on_fire, &log);
+    simulith_timer_start(wheel, &timer, 10 * RES_NS, 10 * RES_NS);
+
+    for (uint64_t t = 1; t <= 100; ++t)
+        simulith_timer_wheel_advance(wheel, t * RES_NS);
+    TEST_ASSERT_EQUAL_INT(10, log.fired);
+
+    // A large step skips missed periods instead of firing a burst
+    simulith_timer_wheel_advance(wheel, 1000 * RES_NS);
+    TEST_ASSERT_EQUAL_INT(11, log.fired);
+    TEST_ASSERT_EQUAL_UINT64(1010 * RES_NS, timer.deadline_ns);
+
+    simulith_timer_cancel(wheel, &timer);
+    simulith_timer_wheel_advance(wheel, 2000 * RES_NS);
+    TEST_ASSERT_EQUAL_INT(11, log.fired);
+}
+
+// Deadlines on every level of the wheel, and past its span, fire at the right time
+static void test_timer_all_levels(void)
+{
+    static const uint64_t deadlines[] = { 3, 63, 64, 65, 4095, 4096, 4097, 262143, 262144, 300000, 17000000, 40000000 };
+    enum { COUNT = sizeof(deadlines) / sizeof(deadlines[0]) };
+    fire_log_t       logs[COUNT];
+    simulith_timer_t timers[COUNT];
+    memset(logs, 0, sizeof(logs));
+
+    for (int i = 0; i < COUNT; ++i)
+    {
+        simulith_timer_init(&timers[i], on_fire, &logs[i]);
+        simulith_timer_start(wheel, &timers[i], deadlines[i] * RES_NS, 0);
+    }
+
+    uint64_t steps[] = { 1, 2, 3, 62, 63, 64, 65, 4000, 4095, 4096, 4097, 262143, 262144, 299999, 300000,
+                         16999999, 17000000, 39999999, 40000000 };
+    for (size_t s = 0; s < sizeof(steps) / sizeof(steps[0]); ++s)
+    {
+        simulith_timer_wheel_advance(wheel, steps[s] * RES_NS);
+        for (int i = 0; i < COUNT; ++i)
+        {
+            TEST_ASSERT_EQUAL_INT(deadlines[i] <= steps[s] ? 1 : 0, logs[i].fired);
+            if (logs[i].fired)
+                TEST_ASSERT_TRUE(logs[i].last_now_ns >= deadlines[i] * RES_NS);
+        }
+    }
+}
+
+typedef struct
+{
+    simulith_timer_t* other;
+    int               fired;
+} cancel_arg_t;
+
+static void cancel_other(void* arg, uint64_t now_ns)
+{
+    cancel_arg_t* c = (cancel_arg_t*)arg;
+    c->fired++;
+    simulith_timer_cancel(wheel, c->other);
+}
+
+// A callback may cancel a timer due in the same slot
+static void test_timer_cancel_from_callback(void)
+{
+    cancel_arg_t     a = {0}, b = {0};
+    simulith_timer_t ta, tb;
+    simulith_timer_init(&ta, cancel_other, &a);
+    simulith_timer_init(&tb, cancel_other, &b);
+    a.other = &tb;
+    b.other = &ta;
+    simulith_timer_start(wheel, &ta, 5 * RES_NS, 0);
+    simulith_timer_start(wheel, &tb, 5 * RES_NS, 0);
+
+    TEST_ASSERT_EQUAL_INT(1, simulith_timer_wheel_advance(wheel, 5 * RES_NS));
+    TEST_ASSERT_EQUAL_INT(1, a.fired + b.fired);
+}
+
+static void test_timer_invalid_params(void)
+{
+    simulith_timer_t timer;
+    simulith_timer_init(&timer, NULL, NULL);
+    TEST_ASSERT_NULL(simulith_timer_wheel_create(0));
+    TEST_ASSERT_EQUAL_INT(-1, simulith_timer_start(wheel, &timer, 0, 0)); // no callback
+    TEST_ASSERT_EQUAL_INT(-1, simulith_timer_start(NULL, &timer, 0, 0));
+    TEST_ASSERT_EQUAL_INT(-1, simulith_timer_wheel_advance(NULL, 0));
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_timer_one_shot_never_early);
+    RUN_TEST(test_timer_periodic_and_cancel);
+    RUN_TEST(test_timer_all_levels);
+    RUN_TEST(test_timer_cancel_from_callback);
+    RUN_TEST(test_timer_invalid_params);
+    return UNITY_END();
+}
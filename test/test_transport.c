@@ -21,6 +21,13 @@ void tearDown(void)
     }
 }
 
+static simulith_transport_stats_t port_stats(const transport_port_t *port)
+{
+    simulith_transport_stats_t stats;
+    TEST_ASSERT_EQUAL(SIMULITH_TRANSPORT_SUCCESS, simulith_transport_get_stats(port, &stats));
+    return stats;
+}
+
 static void test_transport_init(void)
 {
     int result;
@@ -38,6 +45,9 @@ static void test_transport_init(void)
     result = simulith_transport_init(&transport_b_ports[0]);
     TEST_ASSERT_EQUAL(SIMULITH_TRANSPORT_SUCCESS, result);
 
+    /* Ports in one process share the ZMQ context */
+    TEST_ASSERT_EQUAL_PTR(transport_a_ports[0].zmq_ctx, transport_b_ports[0].zmq_ctx);
+
     /* Example: port 1, A (server) and B (client) */
     strcpy(transport_a_ports[1].name, "tp1_a");
     strcpy(transport_a_ports[1].address, LOCAL_REP_ADDR);
@@ -241,6 +251,718 @@ static void test_transport_partial_receive(void)
     free(big);
 }
 
+static void test_transport_ring_wraparound(void)
+{
+    /* Initialize a pair */
+    strcpy(transport_a_ports[5].name, "tp5_a");
+    strcpy(transport_a_ports[5].address, "ipc:///tmp/simulith_pub:7005");
+    transport_a_ports[5].is_server = 1;
+    TEST_ASSERT_EQUAL(SIMULITH_TRANSPORT_SUCCESS, simulith_transport_init(&transport_a_ports[5]));
+
+    strcpy(transport_b_ports[5].name, "tp5_b");
+    strcpy(transport_b_ports[5].address, "ipc:///tmp/simulith_pub:7005");
+    transport_b_ports[5].is_server = 0;
+    TEST_ASSERT_EQUAL(SIMULITH_TRANSPORT_SUCCESS, simulith_transport_init(&transport_b_ports[5]));
+
+    /* Move the ring's head most of the way round so the next message wraps */
+    const size_t first = SIMULITH_TRANSPORT_BUFFER_SIZE - 96;
+    const size_t second = 200;
+    uint8_t *data = malloc(first);
+    TEST_ASSERT_NOT_NULL(data);
+    for (size_t i = 0; i < first; ++i) data[i] = (uint8_t)(i * 7);
+
+    usleep(1000);
+    TEST_ASSERT_EQUAL((int)first, simulith_transport_send(&transport_b_ports[5], data, first));
+    int avail = 0;
+    for (int j = 0; j < 200 && !avail; ++j) {
+        avail = simulith_transport_available(&transport_a_ports[5]);
+        if (!avail) usleep(1000);
+    }
+    TEST_ASSERT_TRUE(avail == 1);
+    TEST_ASSERT_EQUAL((int)first, simulith_transport_consume(&transport_a_ports[5], first + 10));
+
+    TEST_ASSERT_EQUAL((int)second, simulith_transport_send(&transport_b_ports[5], data, second));
+    avail = 0;
+    for (int j = 0; j < 200 && !avail; ++j) {
+        avail = simulith_transport_available(&transport_a_ports[5]);
+        if (!avail) usleep(1000);
+    }
+    TEST_ASSERT_TRUE(avail == 1);
+
+    /* The contiguous span stops at the end of the ring */
+    const uint8_t *span = NULL;
+    TEST_ASSERT_EQUAL(96, simulith_transport_rx_span(&transport_a_ports[5], &span));
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(data, span, 96);
+
+    /* Peek sees across the wrap without consuming */
+    uint8_t out[256];
+    TEST_ASSERT_EQUAL((int)second, simulith_transport_peek(&transport_a_ports[5], out, sizeof(out)));
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(data, out, second);
+
+    TEST_ASSERT_EQUAL(10, simulith_transport_consume(&transport_a_ports[5], 10));
+    TEST_ASSERT_EQUAL((int)(second - 10), simulith_transport_receive(&transport_a_ports[5], out, sizeof(out)));
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(data + 10, out, second - 10);
+    TEST_ASSERT_EQUAL(0, simulith_transport_rx_span(&transport_a_ports[5], &span));
+
+    free(data);
+}
+
+static void test_transport_batch_drain(void)
+{
+    /* Initialize a pair, with a small ring on the receiving side */
+    strcpy(transport_a_ports[6].name, "tp6_a");
+    strcpy(transport_a_ports[6].address, "ipc:///tmp/simulith_pub:7006");
+    transport_a_ports[6].is_server = 1;
+    simulith_transport_config_t small = { .rx_buf_size = 100 }; /* Rounded up to 128 */
+    TEST_ASSERT_EQUAL(SIMULITH_TRANSPORT_SUCCESS, simulith_transport_init_config(&transport_a_ports[6], &small));
+
+    strcpy(transport_b_ports[6].name, "tp6_b");
+    strcpy(transport_b_ports[6].address, "ipc:///tmp/simulith_pub:7006");
+    transport_b_ports[6].is_server = 0;
+    TEST_ASSERT_EQUAL(SIMULITH_TRANSPORT_SUCCESS, simulith_transport_init(&transport_b_ports[6]));
+    usleep(1000);
+
+    /* A burst of small frames is ingested by a single availability check */
+    uint8_t frame[60];
+    for (int i = 0; i < 4; ++i) {
+        memset(frame, i, sizeof(frame));
+        TEST_ASSERT_EQUAL(10, simulith_transport_send(&transport_b_ports[6], frame, 10));
+    }
+    usleep(20000);
+    TEST_ASSERT_EQUAL(1, simulith_transport_available(&transport_a_ports[6]));
+    TEST_ASSERT_EQUAL_UINT64(4, port_stats(&transport_a_ports[6]).rx_msgs);
+
+    /* Receive still returns one message at a time */
+    uint8_t out[128];
+    for (int i = 0; i < 4; ++i) {
+        TEST_ASSERT_EQUAL(10, simulith_transport_receive(&transport_a_ports[6], out, sizeof(out)));
+        TEST_ASSERT_EACH_EQUAL_UINT8(i, out, 10);
+    }
+
+    /* Messages that do not fit yet wait in the socket; oversized ones are dropped */
+    uint8_t big[200] = {0};
+    TEST_ASSERT_EQUAL((int)sizeof(big), simulith_transport_send(&transport_b_ports[6], big, sizeof(big)));
+    for (int i = 0; i < 3; ++i) {
+        memset(frame, 0x10 + i, sizeof(frame));
+        TEST_ASSERT_EQUAL((int)sizeof(frame), simulith_transport_send(&transport_b_ports[6], frame, sizeof(frame)));
+    }
+    usleep(20000);
+    TEST_ASSERT_EQUAL(1, simulith_transport_available(&transport_a_ports[6]));
+    TEST_ASSERT_EQUAL_UINT64(6, port_stats(&transport_a_ports[6]).rx_msgs);
+    TEST_ASSERT_EQUAL_UINT64(1, port_stats(&transport_a_ports[6]).rx_dropped);
+
+    for (int i = 0; i < 3; ++i) {
+        TEST_ASSERT_EQUAL(1, simulith_transport_available(&transport_a_ports[6]));
+        TEST_ASSERT_EQUAL((int)sizeof(frame), simulith_transport_receive(&transport_a_ports[6], out, sizeof(out)));
+        TEST_ASSERT_EACH_EQUAL_UINT8(0x10 + i, out, sizeof(frame));
+    }
+    TEST_ASSERT_EQUAL(0, simulith_transport_available(&transport_a_ports[6]));
+    TEST_ASSERT_EQUAL_UINT64(7, port_stats(&transport_a_ports[6]).rx_msgs);
+}
+
+static int zc_freed;
+
+static void zc_free(void *data, void *hint)
+{
+    (void)hint;
+    free(data);
+    zc_freed++;
+}
+
+static void test_transport_zero_copy(void)
+{
+    /* Initialize a pair */
+    strcpy(transport_a_ports[7].name, "tp7_a");
+    strcpy(transport_a_ports[7].address, "ipc:///tmp/simulith_pub:7011");
+    transport_a_ports[7].is_server = 1;
+    TEST_ASSERT_EQUAL(SIMULITH_TRANSPORT_SUCCESS, simulith_transport_init(&transport_a_ports[7]));
+
+    strcpy(transport_b_ports[7].name, "tp7_b");
+    strcpy(transport_b_ports[7].address, "ipc:///tmp/simulith_pub:7011");
+    transport_b_ports[7].is_server = 0;
+    TEST_ASSERT_EQUAL(SIMULITH_TRANSPORT_SUCCESS, simulith_transport_init(&transport_b_ports[7]));
+    usleep(1000);
+
+    simulith_transport_view_t view;
+    TEST_ASSERT_EQUAL(0, simulith_transport_borrow(&transport_a_ports[7], &view));
+
+    /* A payload larger than the RX ring goes out and comes back without copies */
+    zc_freed = 0;
+    const size_t big = 2 * SIMULITH_TRANSPORT_BUFFER_SIZE;
+    uint8_t *payload = malloc(big);
+    TEST_ASSERT_NOT_NULL(payload);
+    for (size_t i = 0; i < big; ++i) payload[i] = (uint8_t)(i * 3);
+    TEST_ASSERT_EQUAL((int)big, simulith_transport_send_zc(&transport_b_ports[7], payload, big, zc_free, NULL));
+
+    int got = 0;
+    for (int j = 0; j < 200 && !got; ++j) {
+        got = simulith_transport_borrow(&transport_a_ports[7], &view);
+        if (!got) usleep(1000);
+    }
+    TEST_ASSERT_EQUAL(1, got);
+    TEST_ASSERT_EQUAL(big, view.len);
+    for (size_t i = 0; i < big; ++i) {
+        if (view.data[i] != (uint8_t)(i * 3)) TEST_FAIL_MESSAGE("payload mismatch");
+    }
+    simulith_transport_release(&view);
+    TEST_ASSERT_NULL(view.data);
+    for (int j = 0; j < 200 && zc_freed == 0; ++j) usleep(1000);
+    TEST_ASSERT_EQUAL(1, zc_freed);
+
+    /* Data already buffered by available() is lent in place, in order */
+    TEST_ASSERT_EQUAL(3, simulith_transport_send(&transport_b_ports[7], (const uint8_t *)"abc", 3));
+    TEST_ASSERT_EQUAL(2, simulith_transport_send(&transport_b_ports[7], (const uint8_t *)"de", 2));
+    usleep(20000);
+    TEST_ASSERT_EQUAL(1, simulith_transport_available(&transport_a_ports[7]));
+    TEST_ASSERT_EQUAL(1, simulith_transport_borrow(&transport_a_ports[7], &view));
+    TEST_ASSERT_EQUAL(0, view.has_msg);
+    TEST_ASSERT_EQUAL(3, view.len);
+    TEST_ASSERT_EQUAL_MEMORY("abc", view.data, 3);
+    simulith_transport_release(&view);
+    TEST_ASSERT_EQUAL(1, simulith_transport_borrow(&transport_a_ports[7], &view));
+    TEST_ASSERT_EQUAL(2, view.len);
+    TEST_ASSERT_EQUAL_MEMORY("de", view.data, 2);
+    simulith_transport_release(&view);
+    TEST_ASSERT_EQUAL(0, simulith_transport_available(&transport_a_ports[7]));
+
+    /* The free callback also runs when the send cannot happen */
+    transport_port_t uninit = {0};
+    TEST_ASSERT_EQUAL(SIMULITH_TRANSPORT_ERROR, simulith_transport_send_zc(&uninit, malloc(8), 8, zc_free, NULL));
+    TEST_ASSERT_EQUAL(2, zc_freed);
+}
+
+static void test_transport_reactor(void)
+{
+    TEST_ASSERT_EQUAL(SIMULITH_TRANSPORT_SUCCESS, simulith_transport_reactor_start());
+    TEST_ASSERT_EQUAL(SIMULITH_TRANSPORT_SUCCESS, simulith_transport_reactor_start());
+
+    /* Initialize a pair; both are serviced by the reactor thread */
+    strcpy(transport_a_ports[0].name, "tr_a");
+    strcpy(transport_a_ports[0].address, "ipc:///tmp/simulith_pub:7012");
+    transport_a_ports[0].is_server = 1;
+    TEST_ASSERT_EQUAL(SIMULITH_TRANSPORT_SUCCESS, simulith_transport_init(&transport_a_ports[0]));
+
+    strcpy(transport_b_ports[0].name, "tr_b");
+    strcpy(transport_b_ports[0].address, "ipc:///tmp/simulith_pub:7012");
+    transport_b_ports[0].is_server = 0;
+    TEST_ASSERT_EQUAL(SIMULITH_TRANSPORT_SUCCESS, simulith_transport_init(&transport_b_ports[0]));
+    TEST_ASSERT_EQUAL(SIMULITH_TRANSPORT_ERROR, simulith_transport_reactor_stop());
+    usleep(10000);
+
+    TEST_ASSERT_EQUAL(0, simulith_transport_available(&transport_a_ports[0]));
+    for (int i = 0; i < 20; ++i) {
+        uint8_t b = (uint8_t)i;
+        TEST_ASSERT_EQUAL(1, simulith_transport_send(&transport_b_ports[0], &b, 1));
+    }
+    TEST_ASSERT_EQUAL(4, simulith_transport_send(&transport_a_ports[0], (const uint8_t *)"pong", 4));
+
+    uint8_t out[8];
+    for (int i = 0; i < 20; ++i) {
+        int avail = 0;
+        for (int j = 0; j < 200 && !avail; ++j) {
+            avail = simulith_transport_available(&transport_a_ports[0]);
+            if (!avail) usleep(1000);
+        }
+        TEST_ASSERT_EQUAL(1, avail);
+        TEST_ASSERT_EQUAL(1, simulith_transport_receive(&transport_a_ports[0], out, sizeof(out)));
+        TEST_ASSERT_EQUAL_UINT8(i, out[0]);
+    }
+
+    simulith_transport_view_t view;
+    int got = 0;
+    for (int j = 0; j < 200 && !got; ++j) {
+        got = simulith_transport_borrow(&transport_b_ports[0], &view);
+        if (!got) usleep(1000);
+    }
+    TEST_ASSERT_EQUAL(1, got);
+    TEST_ASSERT_EQUAL(4, view.len);
+    TEST_ASSERT_EQUAL_MEMORY("pong", view.data, 4);
+    simulith_transport_release(&view);
+
+    TEST_ASSERT_EQUAL(SIMULITH_TRANSPORT_SUCCESS, simulith_transport_close(&transport_a_ports[0]));
+    TEST_ASSERT_EQUAL(SIMULITH_TRANSPORT_SUCCESS, simulith_transport_close(&transport_b_ports[0]));
+    TEST_ASSERT_EQUAL(SIMULITH_TRANSPORT_SUCCESS, simulith_transport_reactor_stop());
+}
+
+static void test_transport_inproc_fast_path(void)
+{
+    char endpoint[256];
+    size_t len;
+
+    strcpy(transport_a_ports[1].name, "tip_a");
+    strcpy(transport_a_ports[1].address, "ipc:///tmp/simulith_pub:7013");
+    transport_a_ports[1].is_server = 1;
+    TEST_ASSERT_EQUAL(SIMULITH_TRANSPORT_SUCCESS, simulith_transport_init(&transport_a_ports[1]));
+
+    /* A peer in the same process is connected through inproc */
+    strcpy(transport_b_ports[1].name, "tip_b");
+    strcpy(transport_b_ports[1].address, "ipc:///tmp/simulith_pub:7013");
+    transport_b_ports[1].is_server = 0;
+    TEST_ASSERT_EQUAL(SIMULITH_TRANSPORT_SUCCESS, simulith_transport_init(&transport_b_ports[1]));
+    len = sizeof(endpoint);
+    TEST_ASSERT_EQUAL(0, zmq_getsockopt(transport_b_ports[1].zmq_sock, ZMQ_LAST_ENDPOINT, endpoint, &len));
+    TEST_ASSERT_EQUAL(0, strncmp(endpoint, "inproc://", 9));
+
+    TEST_ASSERT_EQUAL(5, simulith_transport_send(&transport_b_ports[1], (const uint8_t *)"hello", 5));
+    int avail = 0;
+    for (int j = 0; j < 200 && !avail; ++j) {
+        avail = simulith_transport_available(&transport_a_ports[1]);
+        if (!avail) usleep(1000);
+    }
+    TEST_ASSERT_EQUAL(1, avail);
+    uint8_t out[8];
+    TEST_ASSERT_EQUAL(5, simulith_transport_receive(&transport_a_ports[1], out, sizeof(out)));
+    TEST_ASSERT_EQUAL_MEMORY("hello", out, 5);
+
+    /* Configuration can turn the fast path off */
+    setenv("SIMULITH_TRANSPORT_INPROC", "0", 1);
+    strcpy(transport_a_ports[2].name, "tip2_a");
+    strcpy(transport_a_ports[2].address, "ipc:///tmp/simulith_pub:7014");
+    transport_a_ports[2].is_server = 1;
+    TEST_ASSERT_EQUAL(SIMULITH_TRANSPORT_SUCCESS, simulith_transport_init(&transport_a_ports[2]));
+    strcpy(transport_b_ports[2].name, "tip2_b");
+    strcpy(transport_b_ports[2].address, "ipc:///tmp/simulith_pub:7014");
+    transport_b_ports[2].is_server = 0;
+    TEST_ASSERT_EQUAL(SIMULITH_TRANSPORT_SUCCESS, simulith_transport_init(&transport_b_ports[2]));
+    unsetenv("SIMULITH_TRANSPORT_INPROC");
+    len = sizeof(endpoint);
+    TEST_ASSERT_EQUAL(0, zmq_getsockopt(transport_b_ports[2].zmq_sock, ZMQ_LAST_ENDPOINT, endpoint, &len));
+    TEST_ASSERT_EQUAL_STRING("ipc:///tmp/simulith_pub:7014", endpoint);
+}
+
+static int wait_receive(transport_port_t *port, uint8_t *buf, size_t len)
+{
+    for (int j = 0; j < 200; ++j) {
+        if (simulith_transport_available(port)) return simulith_transport_receive(port, buf, len);
+        usleep(1000);
+    }
+    return 0;
+}
+
+static void test_transport_bus_broker(void)
+{
+    const char *bus = "ipc:///tmp/simulith_bus:7015";
+    TEST_ASSERT_NULL(simulith_bus_broker_start(NULL));
+    simulith_bus_broker_t *broker = simulith_bus_broker_start(bus);
+    TEST_ASSERT_NOT_NULL(broker);
+
+    /* One master port and two devices on the same bus */
+    strcpy(transport_a_ports[3].name, "i2c_master");
+    strcpy(transport_a_ports[3].address, bus);
+    simulith_transport_config_t master = { .mode = SIMULITH_TRANSPORT_BUS_MASTER };
+    TEST_ASSERT_EQUAL(SIMULITH_TRANSPORT_SUCCESS, simulith_transport_init_config(&transport_a_ports[3], &master));
+
+    uint16_t addrs[2] = { 0x50, 0x68 };
+    for (int i = 0; i < 2; ++i) {
+        sprintf(transport_b_ports[3 + i].name, "i2c_dev_%02x", addrs[i]);
+        strcpy(transport_b_ports[3 + i].address, bus);
+        simulith_transport_config_t device = { .mode = SIMULITH_TRANSPORT_BUS_DEVICE, .bus_addr = addrs[i] };
+        TEST_ASSERT_EQUAL(SIMULITH_TRANSPORT_SUCCESS, simulith_transport_init_config(&transport_b_ports[3 + i], &device));
+    }
+    usleep(20000);
+
+    /* Only bus masters address devices */
+    TEST_ASSERT_EQUAL(SIMULITH_TRANSPORT_ERROR, simulith_transport_bus_send(&transport_b_ports[3], 0x68, (const uint8_t *)"x", 1));
+
+    /* The transaction reaches only the addressed device, without the prefix */
+    uint8_t out[16];
+    TEST_ASSERT_EQUAL(2, simulith_transport_bus_send(&transport_a_ports[3], 0x68, (const uint8_t *)"rd", 2));
+    TEST_ASSERT_EQUAL(2, wait_receive(&transport_b_ports[4], out, sizeof(out)));
+    TEST_ASSERT_EQUAL_MEMORY("rd", out, 2);
+    TEST_ASSERT_EQUAL(0, simulith_transport_available(&transport_b_ports[3]));
+
+    /* The reply comes back tagged with the device address */
+    TEST_ASSERT_EQUAL(3, simulith_transport_send(&transport_b_ports[4], (const uint8_t *)"abc", 3));
+    TEST_ASSERT_EQUAL(5, wait_receive(&transport_a_ports[3], out, sizeof(out)));
+    TEST_ASSERT_EQUAL_MEMORY("\x00\x68" "abc", out, 5);
+
+    /* Absent devices drop the transaction; the bus keeps working */
+    TEST_ASSERT_EQUAL(1, simulith_transport_bus_send(&transport_a_ports[3], 0x11, (const uint8_t *)"?", 1));
+    TEST_ASSERT_EQUAL(1, simulith_transport_bus_send(&transport_a_ports[3], 0x50, (const uint8_t *)"!", 1));
+    TEST_ASSERT_EQUAL(1, wait_receive(&transport_b_ports[3], out, sizeof(out)));
+    TEST_ASSERT_EQUAL_UINT8('!', out[0]);
+
+    simulith_transport_close(&transport_a_ports[3]);
+    simulith_transport_close(&transport_b_ports[3]);
+    simulith_transport_close(&transport_b_ports[4]);
+    simulith_bus_broker_stop(broker);
+}
+
+static void wait_ingested(transport_port_t *port, uint64_t msgs)
+{
+    for (int j = 0; j < 200 && port_stats(port).rx_msgs < msgs; ++j) {
+        simulith_transport_available(port);
+        if (port_stats(port).rx_msgs < msgs) usleep(1000);
+    }
+    TEST_ASSERT_EQUAL_UINT64(msgs, port_stats(port).rx_msgs);
+}
+
+static void test_transport_uart_link_model(void)
+{
+    const uint64_t byte_ns = 1041667; /* 10 bits at 9600 baud, rounded up */
+    const uint64_t t0 = 5000000000ULL;
+
+    strcpy(transport_a_ports[4].name, "uart_a");
+    strcpy(transport_a_ports[4].address, "ipc:///tmp/simulith_pub:7016");
+    transport_a_ports[4].is_server = 1;
+    simulith_transport_config_t uart = { .uart_baud = 9600, .uart_fifo_depth = 4 };
+    TEST_ASSERT_EQUAL(SIMULITH_TRANSPORT_SUCCESS, simulith_transport_init_config(&transport_a_ports[4], &uart));
+
+    strcpy(transport_b_ports[4].name, "uart_b");
+    strcpy(transport_b_ports[4].address, "ipc:///tmp/simulith_pub:7016");
+    transport_b_ports[4].is_server = 0;
+    TEST_ASSERT_EQUAL(SIMULITH_TRANSPORT_SUCCESS, simulith_transport_init(&transport_b_ports[4]));
+    usleep(1000);
+
+    /* Nothing is readable until a whole byte time has passed */
+    simulith_transport_set_time(t0);
+    TEST_ASSERT_EQUAL(3, simulith_transport_send(&transport_b_ports[4], (const uint8_t *)"abc", 3));
+    wait_ingested(&transport_a_ports[4], 1);
+    TEST_ASSERT_EQUAL(0, simulith_transport_available(&transport_a_ports[4]));
+
+    simulith_transport_set_time(t0 + 2 * byte_ns);
+    uint8_t out[16];
+    TEST_ASSERT_EQUAL(1, simulith_transport_available(&transport_a_ports[4]));
+    TEST_ASSERT_EQUAL(2, simulith_transport_receive(&transport_a_ports[4], out, sizeof(out)));
+    TEST_ASSERT_EQUAL_MEMORY("ab", out, 2);
+
+    /* A second message queues behind the first on the line */
+    TEST_ASSERT_EQUAL(2, simulith_transport_send(&transport_b_ports[4], (const uint8_t *)"de", 2));
+    wait_ingested(&transport_a_ports[4], 2);
+    simulith_transport_set_time(t0 + 4 * byte_ns);
+    TEST_ASSERT_EQUAL(1, simulith_transport_available(&transport_a_ports[4]));
+    TEST_ASSERT_EQUAL(2, simulith_transport_receive(&transport_a_ports[4], out, sizeof(out)));
+    TEST_ASSERT_EQUAL_MEMORY("cd", out, 2);
+    simulith_transport_set_time(t0 + 5 * byte_ns);
+    TEST_ASSERT_EQUAL(1, simulith_transport_available(&transport_a_ports[4]));
+    TEST_ASSERT_EQUAL(1, simulith_transport_receive(&transport_a_ports[4], out, sizeof(out)));
+    TEST_ASSERT_EQUAL_UINT8('e', out[0]);
+    TEST_ASSERT_EQUAL_UINT64(0, port_stats(&transport_a_ports[4]).uart_overruns);
+
+    /* Bytes arriving while the 4-byte FIFO is full are lost */
+    const uint64_t t1 = t0 + 100 * byte_ns;
+    simulith_transport_set_time(t1);
+    TEST_ASSERT_EQUAL(10, simulith_transport_send(&transport_b_ports[4], (const uint8_t *)"0123456789", 10));
+    wait_ingested(&transport_a_ports[4], 3);
+    simulith_transport_set_time(t1 + 10 * byte_ns);
+    TEST_ASSERT_EQUAL(1, simulith_transport_available(&transport_a_ports[4]));
+    TEST_ASSERT_EQUAL(4, simulith_transport_receive(&transport_a_ports[4], out, sizeof(out)));
+    TEST_ASSERT_EQUAL_MEMORY("0123", out, 4);
+    TEST_ASSERT_EQUAL_UINT64(6, port_stats(&transport_a_ports[4]).uart_overruns);
+    TEST_ASSERT_EQUAL(0, simulith_transport_available(&transport_a_ports[4]));
+}
+
+static void test_transport_stamped_delivery(void)
+{
+    const uint64_t tick_ns = 10000000;
+    const uint64_t t0 = 7000000000ULL;
+    simulith_transport_config_t stamped = { .stamped = 1 };
+
+    strcpy(transport_a_ports[4].name, "stamp_a");
+    strcpy(transport_a_ports[4].address, "ipc:///tmp/simulith_pub:7017");
+    transport_a_ports[4].is_server = 1;
+    simulith_transport_config_t delayed = { .stamped = 1, .delivery_delay_ns = tick_ns };
+    TEST_ASSERT_EQUAL(SIMULITH_TRANSPORT_SUCCESS, simulith_transport_init_config(&transport_a_ports[4], &delayed));
+
+    strcpy(transport_b_ports[4].name, "stamp_b");
+    strcpy(transport_b_ports[4].address, "ipc:///tmp/simulith_pub:7017");
+    transport_b_ports[4].is_server = 0;
+    TEST_ASSERT_EQUAL(SIMULITH_TRANSPORT_SUCCESS, simulith_transport_init_config(&transport_b_ports[4], &stamped));
+    usleep(1000);
+
+    /* Messages sent during a tick are held until the next one */
+    simulith_transport_set_time(t0);
+    TEST_ASSERT_EQUAL(3, simulith_transport_send(&transport_b_ports[4], (const uint8_t *)"one", 3));
+    TEST_ASSERT_EQUAL(3, simulith_transport_send(&transport_b_ports[4], (const uint8_t *)"two", 3));
+    wait_ingested(&transport_a_ports[4], 2);
+    TEST_ASSERT_EQUAL(0, simulith_transport_available(&transport_a_ports[4]));
+    simulith_transport_view_t view;
+    TEST_ASSERT_EQUAL(0, simulith_transport_borrow(&transport_a_ports[4], &view));
+
+    /* A message from the next tick stays held while the earlier ones are released */
+    simulith_transport_set_time(t0 + tick_ns);
+    TEST_ASSERT_EQUAL(5, simulith_transport_send(&transport_b_ports[4], (const uint8_t *)"three", 5));
+    wait_ingested(&transport_a_ports[4], 3);
+    uint8_t out[16];
+    TEST_ASSERT_EQUAL(1, simulith_transport_available(&transport_a_ports[4]));
+    TEST_ASSERT_EQUAL(3, simulith_transport_receive(&transport_a_ports[4], out, sizeof(out)));
+    TEST_ASSERT_EQUAL_MEMORY("one", out, 3);
+    TEST_ASSERT_EQUAL(1, simulith_transport_borrow(&transport_a_ports[4], &view));
+    TEST_ASSERT_EQUAL(3, view.len);
+    TEST_ASSERT_EQUAL_MEMORY("two", view.data, 3);
+    simulith_transport_release(&view);
+    TEST_ASSERT_EQUAL(0, simulith_transport_available(&transport_a_ports[4]));
+
+    simulith_transport_set_time(t0 + 2 * tick_ns);
+    TEST_ASSERT_EQUAL(1, simulith_transport_available(&transport_a_ports[4]));
+    TEST_ASSERT_EQUAL(5, simulith_transport_receive(&transport_a_ports[4], out, sizeof(out)));
+    TEST_ASSERT_EQUAL_MEMORY("three", out, 5);
+    TEST_ASSERT_EQUAL_UINT64(0, port_stats(&transport_a_ports[4]).rx_gaps);
+
+    /* Skipped sequence numbers are counted as lost messages; this sender is
+     * a plain port writing the stamps itself */
+    strcpy(transport_a_ports[5].name, "stamp_gap_a");
+    strcpy(transport_a_ports[5].address, "ipc:///tmp/simulith_pub:7021");
+    transport_a_ports[5].is_server = 1;
+    TEST_ASSERT_EQUAL(SIMULITH_TRANSPORT_SUCCESS, simulith_transport_init_config(&transport_a_ports[5], &stamped));
+    strcpy(transport_b_ports[5].name, "stamp_gap_b");
+    strcpy(transport_b_ports[5].address, "ipc:///tmp/simulith_pub:7021");
+    TEST_ASSERT_EQUAL(SIMULITH_TRANSPORT_SUCCESS, simulith_transport_init(&transport_b_ports[5]));
+    usleep(1000);
+    simulith_transport_stamp_t stamp = { .magic = SIMULITH_TRANSPORT_STAMP_MAGIC, .sim_ns = t0 + 2 * tick_ns };
+    uint8_t frame[sizeof(stamp) + 4];
+    memcpy(frame + sizeof(stamp), "four", 4);
+    for (uint32_t seq = 0; seq < 6; seq += 3) {
+        stamp.seq = seq;
+        memcpy(frame, &stamp, sizeof(stamp));
+        TEST_ASSERT_EQUAL((int)sizeof(frame), simulith_transport_send(&transport_b_ports[5], frame, sizeof(frame)));
+    }
+    wait_ingested(&transport_a_ports[5], 2);
+    TEST_ASSERT_EQUAL_UINT64(2, port_stats(&transport_a_ports[5]).rx_gaps);
+    TEST_ASSERT_EQUAL(4, simulith_transport_receive(&transport_a_ports[5], out, sizeof(out)));
+    TEST_ASSERT_EQUAL_MEMORY("four", out, 4);
+
+    /* Stamps do not fit the bus message format */
+    transport_port_t bus = {0};
+    strcpy(bus.name, "stamp_bus");
+    strcpy(bus.address, "ipc:///tmp/simulith_bus:7017");
+    simulith_transport_config_t stamped_bus = { .mode = SIMULITH_TRANSPORT_BUS_MASTER, .stamped = 1 };
+    TEST_ASSERT_EQUAL(SIMULITH_TRANSPORT_ERROR, simulith_transport_init_config(&bus, &stamped_bus));
+}
+
+static void count_stats(const char *name, const simulith_transport_stats_t *stats, void *ctx)
+{
+    if (strcmp(name, "stats_a") == 0) {
+        *(uint64_t *)ctx += stats->rx_msgs;
+    }
+}
+
+static void test_transport_stats(void)
+{
+    simulith_transport_config_t stamped = { .stamped = 1 };
+    strcpy(transport_a_ports[4].name, "stats_a");
+    strcpy(transport_a_ports[4].address, "ipc:///tmp/simulith_pub:7018");
+    transport_a_ports[4].is_server = 1;
+    simulith_transport_config_t sampled = { .rx_buf_size = 16, .stamped = 1, .latency_sample = 1 };
+    TEST_ASSERT_EQUAL(SIMULITH_TRANSPORT_SUCCESS, simulith_transport_init_config(&transport_a_ports[4], &sampled));
+
+    strcpy(transport_b_ports[4].name, "stats_b");
+    strcpy(transport_b_ports[4].address, "ipc:///tmp/simulith_pub:7018");
+    transport_b_ports[4].is_server = 0;
+    TEST_ASSERT_EQUAL(SIMULITH_TRANSPORT_SUCCESS, simulith_transport_init_config(&transport_b_ports[4], &stamped));
+    usleep(1000);
+
+    /* The second message has to wait for the first to be read, the third never fits */
+    uint8_t big[32] = {0};
+    TEST_ASSERT_EQUAL(10, simulith_transport_send(&transport_b_ports[4], big, 10));
+    TEST_ASSERT_EQUAL(10, simulith_transport_send(&transport_b_ports[4], big, 10));
+    TEST_ASSERT_EQUAL(32, simulith_transport_send(&transport_b_ports[4], big, 32));
+    wait_ingested(&transport_a_ports[4], 1);
+    uint8_t out[32];
+    TEST_ASSERT_EQUAL(10, simulith_transport_receive(&transport_a_ports[4], out, sizeof(out)));
+    wait_ingested(&transport_a_ports[4], 2);
+    TEST_ASSERT_EQUAL(10, simulith_transport_receive(&transport_a_ports[4], out, sizeof(out)));
+    for (int i = 0; i < 200 && port_stats(&transport_a_ports[4]).rx_dropped == 0; ++i) {
+        simulith_transport_available(&transport_a_ports[4]);
+        usleep(1000);
+    }
+
+    simulith_transport_stats_t stats;
+    TEST_ASSERT_EQUAL(SIMULITH_TRANSPORT_SUCCESS, simulith_transport_get_stats(&transport_b_ports[4], &stats));
+    TEST_ASSERT_EQUAL_UINT64(3, stats.tx_msgs);
+    TEST_ASSERT_EQUAL_UINT64(52 + 3 * sizeof(simulith_transport_stamp_t), stats.tx_bytes);
+    TEST_ASSERT_EQUAL_UINT64(0, stats.tx_errors);
+
+    TEST_ASSERT_EQUAL(SIMULITH_TRANSPORT_SUCCESS, simulith_transport_get_stats(&transport_a_ports[4], &stats));
+    TEST_ASSERT_EQUAL_UINT64(2, stats.rx_msgs);
+    TEST_ASSERT_EQUAL_UINT64(20, stats.rx_bytes);
+    TEST_ASSERT_EQUAL_UINT64(1, stats.rx_dropped);
+    TEST_ASSERT_EQUAL_UINT64(1, stats.rx_overflows);
+    TEST_ASSERT_EQUAL_UINT64(2, stats.latency_samples);
+    TEST_ASSERT_TRUE(stats.latency_max_ns > 0);
+    TEST_ASSERT_TRUE(stats.latency_mean_ns <= stats.latency_max_ns);
+
+    /* Every open port is listed */
+    uint64_t listed = 0;
+    TEST_ASSERT_TRUE(simulith_transport_foreach_stats(count_stats, &listed) >= 2);
+    TEST_ASSERT_EQUAL_UINT64(2, listed);
+
+    simulith_transport_reset_stats(&transport_a_ports[4]);
+    TEST_ASSERT_EQUAL(SIMULITH_TRANSPORT_SUCCESS, simulith_transport_get_stats(&transport_a_ports[4], &stats));
+    TEST_ASSERT_EQUAL_UINT64(0, stats.rx_msgs);
+    TEST_ASSERT_EQUAL_UINT64(0, stats.latency_samples);
+
+    /* Closed ports drop out of the list */
+    simulith_transport_close(&transport_a_ports[4]);
+    listed = 0;
+    simulith_transport_foreach_stats(count_stats, &listed);
+    TEST_ASSERT_EQUAL_UINT64(0, listed);
+    TEST_ASSERT_EQUAL(SIMULITH_TRANSPORT_ERROR, simulith_transport_get_stats(&transport_a_ports[4], &stats));
+}
+
+static void test_transport_capture(void)
+{
+    const char *path = "/tmp/simulith_capture_test.pcapng";
+    TEST_ASSERT_EQUAL(SIMULITH_TRANSPORT_SUCCESS, simulith_transport_capture_start(path, "other,cap_a*"));
+    TEST_ASSERT_EQUAL(SIMULITH_TRANSPORT_ERROR, simulith_transport_capture_start(path, NULL));
+
+    strcpy(transport_a_ports[4].name, "cap_a");
+    strcpy(transport_a_ports[4].address, "ipc:///tmp/simulith_pub:7019");
+    transport_a_ports[4].is_server = 1;
+    TEST_ASSERT_EQUAL(SIMULITH_TRANSPORT_SUCCESS, simulith_transport_init(&transport_a_ports[4]));
+
+    strcpy(transport_b_ports[4].name, "cap_b");
+    strcpy(transport_b_ports[4].address, "ipc:///tmp/simulith_pub:7019");
+    transport_b_ports[4].is_server = 0;
+    TEST_ASSERT_EQUAL(SIMULITH_TRANSPORT_SUCCESS, simulith_transport_init(&transport_b_ports[4]));
+    usleep(1000);
+
+    uint8_t out[16];
+    simulith_transport_set_time(42);
+    TEST_ASSERT_EQUAL(4, simulith_transport_send(&transport_b_ports[4], (const uint8_t *)"ping", 4));
+    TEST_ASSERT_EQUAL(4, wait_receive(&transport_a_ports[4], out, sizeof(out)));
+    TEST_ASSERT_EQUAL(4, simulith_transport_send(&transport_a_ports[4], (const uint8_t *)"pong", 4));
+    TEST_ASSERT_EQUAL(4, wait_receive(&transport_b_ports[4], out, sizeof(out)));
+    simulith_transport_capture_stop();
+
+    /* Section header, one interface for cap_a, then its received and sent frame */
+    FILE *f = fopen(path, "rb");
+    TEST_ASSERT_NOT_NULL(f);
+    uint8_t file[1024];
+    size_t size = fread(file, 1, sizeof(file), f);
+    fclose(f);
+    uint32_t types[8] = {0};
+    size_t blocks = 0;
+    for (size_t off = 0; off + 12 <= size && blocks < 8; ++blocks) {
+        uint32_t type, len;
+        memcpy(&type, file + off, 4);
+        memcpy(&len, file + off + 4, 4);
+        TEST_ASSERT_TRUE(len >= 12 && off + len <= size);
+        types[blocks] = type;
+        if (type == 1) {
+            TEST_ASSERT_EQUAL_UINT16(147, *(uint16_t *)(file + off + 8));
+            TEST_ASSERT_EQUAL_MEMORY("cap_a", file + off + 20, 5);
+        } else if (type == 6) {
+            uint32_t ts_low, cap_len, flags;
+            memcpy(&ts_low, file + off + 16, 4);
+            memcpy(&cap_len, file + off + 20, 4);
+            memcpy(&flags, file + off + 36, 4);
+            TEST_ASSERT_EQUAL_UINT32(42, ts_low);
+            TEST_ASSERT_EQUAL_UINT32(4, cap_len);
+            TEST_ASSERT_EQUAL_MEMORY(blocks == 2 ? "ping" : "pong", file + off + 28, 4);
+            TEST_ASSERT_EQUAL_UINT32(blocks == 2 ? 1 : 2, flags);
+        }
+        off += len;
+    }
+    TEST_ASSERT_EQUAL(4, blocks);
+    TEST_ASSERT_EQUAL_HEX32(0x0A0D0D0A, types[0]);
+    TEST_ASSERT_EQUAL_UINT32(1, types[1]);
+    TEST_ASSERT_EQUAL_UINT32(6, types[2]);
+    TEST_ASSERT_EQUAL_UINT32(6, types[3]);
+    remove(path);
+}
+
+static void test_transport_large_messages(void)
+{
+    static uint8_t big[10000];
+    static uint8_t out[4096];
+    for (size_t i = 0; i < sizeof(big); ++i) big[i] = (uint8_t)(i * 7);
+
+    /* A growable ring takes messages up to rx_buf_max */
+    strcpy(transport_a_ports[4].name, "grow_a");
+    strcpy(transport_a_ports[4].address, "ipc:///tmp/simulith_pub:7020");
+    transport_a_ports[4].is_server = 1;
+    simulith_transport_config_t growable = { .rx_buf_size = 16, .rx_buf_max = 64 };
+    TEST_ASSERT_EQUAL(SIMULITH_TRANSPORT_SUCCESS, simulith_transport_init_config(&transport_a_ports[4], &growable));
+
+    strcpy(transport_b_ports[4].name, "grow_b");
+    strcpy(transport_b_ports[4].address, "ipc:///tmp/simulith_pub:7020");
+    transport_b_ports[4].is_server = 0;
+    simulith_transport_config_t streaming = { .rx_buf_size = 16, .rx_stream = 1 };
+    TEST_ASSERT_EQUAL(SIMULITH_TRANSPORT_SUCCESS, simulith_transport_init_config(&transport_b_ports[4], &streaming));
+    usleep(1000);
+
+    TEST_ASSERT_EQUAL(10, simulith_transport_send(&transport_b_ports[4], big, 10));
+    TEST_ASSERT_EQUAL(40, simulith_transport_send(&transport_b_ports[4], big, 40));
+    TEST_ASSERT_EQUAL(100, simulith_transport_send(&transport_b_ports[4], big, 100));
+    wait_ingested(&transport_a_ports[4], 2);
+    TEST_ASSERT_EQUAL(10, simulith_transport_receive(&transport_a_ports[4], out, sizeof(out)));
+    TEST_ASSERT_EQUAL(40, simulith_transport_receive(&transport_a_ports[4], out, sizeof(out)));
+    TEST_ASSERT_EQUAL_MEMORY(big, out, 40);
+    for (int i = 0; i < 200 && port_stats(&transport_a_ports[4]).rx_dropped == 0; ++i) {
+        simulith_transport_available(&transport_a_ports[4]);
+        usleep(1000);
+    }
+    TEST_ASSERT_EQUAL_UINT64(1, port_stats(&transport_a_ports[4]).rx_dropped);
+
+    /* A streaming port hands a large message over in chunks, in order */
+    TEST_ASSERT_EQUAL(5, simulith_transport_send(&transport_a_ports[4], (const uint8_t *)"small", 5));
+    TEST_ASSERT_EQUAL(10000, simulith_transport_send(&transport_a_ports[4], big, sizeof(big)));
+    TEST_ASSERT_EQUAL(4, simulith_transport_send(&transport_a_ports[4], (const uint8_t *)"tail", 4));
+    TEST_ASSERT_EQUAL(5, wait_receive(&transport_b_ports[4], out, sizeof(out)));
+    TEST_ASSERT_EQUAL_MEMORY("small", out, 5);
+    size_t got = 0;
+    while (got < sizeof(big)) {
+        int n = wait_receive(&transport_b_ports[4], out, sizeof(out));
+        TEST_ASSERT_TRUE(n > 0);
+        TEST_ASSERT_EQUAL_MEMORY(big + got, out, n);
+        got += (size_t)n;
+    }
+    TEST_ASSERT_EQUAL(sizeof(big), got);
+    TEST_ASSERT_EQUAL(4, wait_receive(&transport_b_ports[4], out, sizeof(out)));
+    TEST_ASSERT_EQUAL_MEMORY("tail", out, 4);
+
+    /* and lends it whole */
+    TEST_ASSERT_EQUAL(10000, simulith_transport_send(&transport_a_ports[4], big, sizeof(big)));
+    for (int i = 0; i < 200 && simulith_transport_available(&transport_b_ports[4]) == 0; ++i) {
+        usleep(1000);
+    }
+    simulith_transport_view_t view;
+    TEST_ASSERT_EQUAL(1, simulith_transport_borrow(&transport_b_ports[4], &view));
+    TEST_ASSERT_EQUAL(sizeof(big), view.len);
+    TEST_ASSERT_EQUAL_MEMORY(big, view.data, sizeof(big));
+    simulith_transport_release(&view);
+    TEST_ASSERT_EQUAL(0, simulith_transport_available(&transport_b_ports[4]));
+    TEST_ASSERT_EQUAL_UINT64(0, port_stats(&transport_b_ports[4]).rx_dropped);
+}
+
+static void test_transport_config(void)
+{
+    /* Settings out of range or that do not go together are refused */
+    const simulith_transport_config_t bad[] = {
+        { .mode = 7 },
+        { .rx_buf_size = (size_t)1 << 31 },
+        { .uart_baud = 9600, .uart_frame_bits = 3 },
+        { .mode = SIMULITH_TRANSPORT_BUS_DEVICE, .stamped = 1 },
+        { .rx_stream = 1, .stamped = 1 },
+        { .rx_stream = 1, .uart_baud = 9600 },
+    };
+    for (size_t i = 0; i < sizeof(bad) / sizeof(bad[0]); ++i) {
+        strcpy(transport_a_ports[4].name, "cfg_a");
+        strcpy(transport_a_ports[4].address, "ipc:///tmp/simulith_pub:7022");
+        transport_a_ports[4].is_server = 1;
+        TEST_ASSERT_EQUAL(SIMULITH_TRANSPORT_ERROR, simulith_transport_init_config(&transport_a_ports[4], &bad[i]));
+        TEST_ASSERT_NULL(transport_a_ports[4].state);
+    }
+
+    /* Only the addressing fields and init are read, so the port need not be zeroed */
+    memset(&transport_a_ports[4], 0xA5, sizeof(transport_a_ports[4]));
+    transport_a_ports[4].init = 0;
+    strcpy(transport_a_ports[4].name, "cfg_a");
+    strcpy(transport_a_ports[4].address, "ipc:///tmp/simulith_pub:7022");
+    transport_a_ports[4].is_server = 1;
+    TEST_ASSERT_EQUAL(SIMULITH_TRANSPORT_SUCCESS, simulith_transport_init(&transport_a_ports[4]));
+
+    strcpy(transport_b_ports[4].name, "cfg_b");
+    strcpy(transport_b_ports[4].address, "ipc:///tmp/simulith_pub:7022");
+    TEST_ASSERT_EQUAL(SIMULITH_TRANSPORT_SUCCESS, simulith_transport_init(&transport_b_ports[4]));
+    usleep(1000);
+    uint8_t out[16];
+    TEST_ASSERT_EQUAL(4, simulith_transport_send(&transport_b_ports[4], (const uint8_t *)"ping", 4));
+    TEST_ASSERT_EQUAL(4, wait_receive(&transport_a_ports[4], out, sizeof(out)));
+    TEST_ASSERT_EQUAL_MEMORY("ping", out, 4);
+}
+
 static void test_transport_flush(void)
 {
     transport_port_t a = {0};
@@ -268,6 +990,18 @@ int main(void)
     RUN_TEST(test_transport_uninitialized_send);
     RUN_TEST(test_transport_multiple_messages);
     RUN_TEST(test_transport_partial_receive);
+    RUN_TEST(test_transport_ring_wraparound);
+    RUN_TEST(test_transport_batch_drain);
+    RUN_TEST(test_transport_zero_copy);
+    RUN_TEST(test_transport_reactor);
+    RUN_TEST(test_transport_inproc_fast_path);
+    RUN_TEST(test_transport_bus_broker);
+    RUN_TEST(test_transport_uart_link_model);
+    RUN_TEST(test_transport_stamped_delivery);
+    RUN_TEST(test_transport_stats);
+    RUN_TEST(test_transport_capture);
+    RUN_TEST(test_transport_large_messages);
+    RUN_TEST(test_transport_config);
     RUN_TEST(test_transport_flush);
     RUN_TEST(test_transport_close_uninitialized);
     return UNITY_END();